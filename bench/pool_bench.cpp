@@ -0,0 +1,69 @@
+// Spawn/despawn churn over a long simulated campaign, numbering instances the way
+// push_actors does. Prints the cost per actor, the memory held by the pools and the
+// string pool, and the palette entries every few rounds; all of them should stay
+// bounded.
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <memory>
+
+#include "ActorSlot.hpp"
+#include "ObjectPool.hpp"
+#include "StringPool.hpp"
+#include "CommandPalette.hpp"
+
+
+template<class Spawn>
+static double churn(std::vector<std::shared_ptr<ActorSlot>>& live_, std::mt19937& engine_, const int& perRound_, Spawn spawn_){
+	const auto tempStart = std::chrono::steady_clock::now();
+	for (int i = 0; i < perRound_; i++) live_.push_back(spawn_(i));
+	for (int i = 0; i < perRound_ && !live_.empty(); i++){
+		const size_t tempVictim = std::uniform_int_distribution<size_t>(0, live_.size() - 1)(engine_);
+		std::swap(live_[tempVictim], live_.back());
+		live_.pop_back();
+	}
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - tempStart).count();
+}
+
+static size_t pool_reserved(){
+	size_t tempReserved = 0;
+	for (const auto& Pi : SlabPool::g_all()) tempReserved += Pi->g_usage().reserved;
+	return tempReserved;
+}
+
+
+int main(int argc, char** argv){
+	const int rounds = argc > 1 ? std::atoi(argv[1]) : 600;
+	const int perRound = argc > 2 ? std::atoi(argv[2]) : 2000;
+	const int standing = argc > 3 ? std::atoi(argv[3]) : 5000;
+
+	ActionsData::init();
+	const auto tempTemplate = ActorTemplate::create("Goblin", std::array<int, 6>{3, 3, 3, 3, 3, 3}, 0);
+
+	for (int mode = 0; mode < 2; mode++){
+		std::mt19937 tempEngine(42);
+		std::vector<std::shared_ptr<ActorSlot>> tempLive;
+		tempLive.reserve(static_cast<size_t>(standing + perRound));
+		tempTemplate->lastNumber = 0;
+		CommandPalette::clear();
+		for (int i = 0; i < standing; i++) tempLive.push_back(ActorSlot::create(tempTemplate, false, ++tempTemplate->lastNumber));
+
+		std::printf("%s: %i rounds of %i spawns + %i despawns, %i standing\n", mode == 0 ? "pool" : "make_shared", rounds, perRound, perRound, standing);
+		double tempWindow = 0.0;
+		for (int r = 1; r <= rounds; r++){
+			if (mode == 0) tempWindow += churn(tempLive, tempEngine, perRound, [&](const int&){ return ActorSlot::create(tempTemplate, false, ++tempTemplate->lastNumber); });
+			else tempWindow += churn(tempLive, tempEngine, perRound, [&](const int&){ return std::make_shared<ActorSlot>(tempTemplate, false, ++tempTemplate->lastNumber); });
+			if (r % 60 == 0){
+				// The palette follows the roster the way the panels do, outside the timed churn.
+				const ActorList tempRoster(tempLive.begin(), tempLive.end());
+				CommandPalette::sync(tempRoster, static_cast<uint64_t>(r));
+				std::printf("  round %4i: %7.3f us per spawn+despawn, pools %8.1f KiB, strings %8.1f KiB, palette %6zu live %8zu ids\n", r, tempWindow / (60.0 * perRound),
+					pool_reserved() / 1024.0, StringPool::global().reserved() / 1024.0, CommandPalette::g_live(), CommandPalette::size());
+				tempWindow = 0.0;
+			}
+		}
+	}
+	return 0;
+}
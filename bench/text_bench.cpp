@@ -0,0 +1,96 @@
+// Text vertex generation throughput: ImFont::RenderText into a bare draw list, for the
+// kinds of strings the panels draw (list reset included). Prints the cost per glyph and
+// a checksum of the vertex and index output, which must not change between builds with
+// and without IMGUI_DISABLE_SSE.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "imgui.h"
+
+
+struct TextCase {
+	const char* name;
+	std::string text;
+	float wrapWidth;
+	bool fineClip;
+	float x;
+};
+
+static uint64_t hash_bytes(uint64_t hash_, const void* data_, const size_t& size_){
+	const unsigned char* tempBytes = static_cast<const unsigned char*>(data_);
+	for (size_t i = 0; i < size_; i++) hash_ = (hash_ ^ tempBytes[i]) * 1099511628211ull;
+	return hash_;
+}
+
+static std::vector<TextCase> make_cases(){
+	std::vector<TextCase> tempCases;
+	tempCases.push_back({"labels", "Name:Goblin", 0.f, false, 10.f});
+	tempCases.push_back({"stats", "Str:3 Dex:2 Mind:1 Agi:4 Infl:2 End:5", 0.f, false, 10.f});
+	tempCases.push_back({"separator", std::string(28, '-'), 0.f, false, 10.f});
+	std::string tempParagraph;
+	for (int i = 0; i < 40; i++) tempParagraph += "Initiative " + std::to_string(i) + ": the goblin rolls 4d10 and keeps the best set\n";
+	tempCases.push_back({"paragraph", tempParagraph, 0.f, false, 10.f});
+	tempCases.push_back({"clipped", tempParagraph, 0.f, false, -300.f});
+	tempCases.push_back({"fine clip", tempParagraph, 0.f, true, 10.f});
+	tempCases.push_back({"wrapped", tempParagraph, 180.f, false, 10.f});
+	tempCases.push_back({"utf-8", "Gr\xc3\xbcn \xc3\xa9p\xc3\xa9\xc3\xa9 \xc3\x9f\xc3\xb8 Str:3 Dex:2", 0.f, false, 10.f});
+	return tempCases;
+}
+
+
+int main(int argc, char** argv){
+	const int batchSize = 256;
+	const int iterations = std::max(argc > 1 ? std::atoi(argv[1]) : 51200, 2 * batchSize) / batchSize * batchSize;
+
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.IniFilename = nullptr;
+	io.Fonts->AddFontDefault();
+	unsigned char* tempPixels;
+	int tempWidth, tempHeight;
+	io.Fonts->GetTexDataAsAlpha8(&tempPixels, &tempWidth, &tempHeight);
+	io.Fonts->TexID = reinterpret_cast<ImTextureID>(static_cast<intptr_t>(1));
+	const ImFont* tempFont = io.Fonts->Fonts[0];
+
+	ImDrawList tempList(ImGui::GetDrawListSharedData());
+	const ImVec4 tempClip(0.f, 0.f, 400.f, 800.f);
+	std::printf("%i iterations per case\n", iterations);
+	for (const TextCase& Ci : make_cases()){
+		const char* tempBegin = Ci.text.c_str();
+		const char* tempEnd = tempBegin + Ci.text.size();
+		uint64_t tempHash = 1469598103934665603ull;
+		size_t tempGlyphs = 0;
+		double tempTime = 0.0;
+		double tempBest = 1e30;
+		// Timed in batches, the best batch is the figure least disturbed by the rest of the machine.
+		for (int i = 0; i < iterations; i += batchSize){
+			size_t tempBatchGlyphs = 0;
+			const auto tempStart = std::chrono::steady_clock::now();
+			for (int b = i; b < i + batchSize; b++){
+				tempList._ResetForNewFrame();
+				tempList.PushClipRect({tempClip.x, tempClip.y}, {tempClip.z, tempClip.w});
+				tempFont->RenderText(&tempList, tempFont->FontSize, {Ci.x, static_cast<float>(b % 64)}, IM_COL32_WHITE, tempClip, tempBegin, tempEnd, Ci.wrapWidth, Ci.fineClip);
+				tempBatchGlyphs += static_cast<size_t>(tempList.VtxBuffer.Size / 4);
+				if (b < 64){
+					tempHash = hash_bytes(tempHash, tempList.VtxBuffer.Data, static_cast<size_t>(tempList.VtxBuffer.Size) * sizeof(ImDrawVert));
+					tempHash = hash_bytes(tempHash, tempList.IdxBuffer.Data, static_cast<size_t>(tempList.IdxBuffer.Size) * sizeof(ImDrawIdx));
+				}
+			}
+			const double tempBatchTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - tempStart).count();
+			tempTime += tempBatchTime;
+			tempGlyphs += tempBatchGlyphs;
+			if (i > 0 && tempBatchGlyphs > 0) tempBest = std::min(tempBest, tempBatchTime / static_cast<double>(tempBatchGlyphs));
+		}
+		std::printf("  %-10s %9.1f ns/call %6.2f ns/glyph avg %6.2f best | %5zu glyphs/call | %016llx\n", Ci.name,
+			tempTime / iterations, tempTime / static_cast<double>(tempGlyphs), tempBest,
+			tempGlyphs / static_cast<size_t>(iterations), static_cast<unsigned long long>(tempHash));
+	}
+	tempList._ClearFreeMemory();
+	ImGui::DestroyContext();
+	return 0;
+}
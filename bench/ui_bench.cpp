@@ -0,0 +1,217 @@
+// Drives the panels headless: an ImGui context with no window and no renderer, a
+// generated scenario (one player in ten, every action filled and rolled) and scripted mouse input. Prints the CPU cost of building a frame,
+// the size of the draw data and the allocations per frame, for each roster size.
+// With --soft the frames are also rasterized on the CPU, timed separately, and the
+// last frame of each panel is written out as a PPM screenshot. Also times the command
+// palette index: a full roster sync, a sync with nothing changed, and each keystroke.
+// Before any of that, checks the contest odds cache filled from empty, small pool first.
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <new>
+
+#include "imgui.h"
+#include "imgui_impl_soft.h"
+
+#include "ActorSlot.hpp"
+#include "GamePanels.hpp"
+#include "TextLayout.hpp"
+#include "CommandPalette.hpp"
+#include "Scenario.hpp"
+#include "ContestOdds.hpp"
+
+
+static size_t allocCount{0};
+
+void* operator new(size_t size_){
+	allocCount++;
+	if (void* tempPtr = std::malloc(size_ ? size_ : 1)) return tempPtr;
+	throw std::bad_alloc();
+}
+void operator delete(void* ptr_) noexcept { std::free(ptr_); }
+void operator delete(void* ptr_, size_t) noexcept { std::free(ptr_); }
+
+static void* imgui_alloc(size_t size_, void*) { allocCount++; return std::malloc(size_); }
+static void imgui_free(void* ptr_, void*) { std::free(ptr_); }
+
+
+static const float displayWidth = 1280.f;
+static const float displayHeight = 800.f;
+static const int warmupFrames = 30;
+static bool softRaster{false};
+static std::vector<ImU32> softPixels;
+
+struct PhaseResult {
+	std::vector<double> frameTimes;
+	std::vector<double> rasterTimes;
+	double vertices{0.0};
+	double indices{0.0};
+	double allocations{0.0};
+};
+
+// Mouse sweeps a Lissajous curve over the window and scrolls; the game tab also gets
+// a click every 20 frames, which opens combos and presses buttons along the way.
+static PhaseResult run_phase(const int& phase_, const int& frames_, const std::string& screenshot_){
+	ImGuiIO& io = ImGui::GetIO();
+	PhaseResult tempResult;
+	tempResult.frameTimes.reserve(static_cast<size_t>(frames_));
+	for (int f = 0; f < frames_ + warmupFrames; f++){
+		const float t = static_cast<float>(f) / 60.f;
+		io.DeltaTime = 1.f / 60.f;
+		io.MousePos = {displayWidth * (0.5f + 0.45f * std::sin(t * 1.3f)), displayHeight * (0.5f + 0.45f * std::sin(t * 0.7f + 1.f))};
+		io.MouseDown[0] = phase_ == 2 && f % 20 == 0;
+		io.MouseWheel = phase_ == 2 ? 0.f : ((f / 200) % 2 ? 1.f : -1.f);
+		io.MouseWheelH = phase_ == 2 ? ((f / 300) % 2 ? 1.f : -1.f) : 0.f;
+
+		const size_t tempAllocs = allocCount;
+		const auto tempStart = std::chrono::steady_clock::now();
+		ImGui::NewFrame();
+		ImGui::SetNextWindowPos({0.f, 0.f});
+		ImGui::SetNextWindowSize({displayWidth, displayHeight});
+		ImGui::Begin("Main", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse);
+		if (phase_ == 2) GamePanels::game_menu();
+		else GamePanels::manage_creatures(phase_ == 1);
+		ImGui::End();
+		ImGui::Render();
+		const double tempTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - tempStart).count();
+
+		if (f < warmupFrames) continue;
+		tempResult.frameTimes.push_back(tempTime);
+		tempResult.vertices += ImGui::GetDrawData()->TotalVtxCount;
+		tempResult.indices += ImGui::GetDrawData()->TotalIdxCount;
+		tempResult.allocations += static_cast<double>(allocCount - tempAllocs);
+
+		if (!softRaster) continue;
+		std::fill(softPixels.begin(), softPixels.end(), IM_COL32(51, 77, 77, 255));
+		const auto tempRasterStart = std::chrono::steady_clock::now();
+		ImGui_ImplSoft_RenderDrawData(ImGui::GetDrawData(), softPixels.data(), static_cast<int>(displayWidth), static_cast<int>(displayHeight));
+		tempResult.rasterTimes.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - tempRasterStart).count());
+	}
+	if (softRaster && !ImGui_ImplSoft_SavePPM(screenshot_.c_str(), softPixels.data(), static_cast<int>(displayWidth), static_cast<int>(displayHeight)))
+		std::printf("  could not write %s\n", screenshot_.c_str());
+	return tempResult;
+}
+
+static void report(const char* name_, PhaseResult& result_){
+	auto& tempTimes = result_.frameTimes;
+	const double tempFrames = static_cast<double>(tempTimes.size());
+	double tempSum = 0.0;
+	for (const double& Ti : tempTimes) tempSum += Ti;
+	std::sort(tempTimes.begin(), tempTimes.end());
+	std::printf("  %-15s %8.1f us avg %8.1f p50 %8.1f p99 %8.1f max | %8.0f vtx %8.0f idx | %7.1f allocs/frame\n", name_,
+		tempSum / tempFrames, tempTimes[tempTimes.size() / 2], tempTimes[tempTimes.size() * 99 / 100], tempTimes.back(),
+		result_.vertices / tempFrames, result_.indices / tempFrames, result_.allocations / tempFrames);
+	auto& tempRaster = result_.rasterTimes;
+	if (tempRaster.empty()) return;
+	double tempRasterSum = 0.0;
+	for (const double& Ti : tempRaster) tempRasterSum += Ti;
+	std::sort(tempRaster.begin(), tempRaster.end());
+	std::printf("  %-15s %8.1f us avg %8.1f p50 %8.1f p99 %8.1f max | software raster\n", "",
+		tempRasterSum / static_cast<double>(tempRaster.size()), tempRaster[tempRaster.size() / 2], tempRaster[tempRaster.size() * 99 / 100], tempRaster.back());
+}
+
+static double elapsed_us(const std::chrono::steady_clock::time_point& start_){
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count();
+}
+
+// Query typed one character at a time, the palette searches again after each one.
+static void bench_palette(){
+	static const char* tempQuery = "gobln 12";
+	const int tempRepeats = 200;
+	CommandPalette::clear();
+	uint64_t tempRevision = 0;
+	auto tempStart = std::chrono::steady_clock::now();
+	CommandPalette::sync(GamePanels::g_creatures(), ++tempRevision);
+	const double tempFull = elapsed_us(tempStart);
+	tempStart = std::chrono::steady_clock::now();
+	CommandPalette::sync(GamePanels::g_creatures(), ++tempRevision);
+	const double tempUnchanged = elapsed_us(tempStart);
+	std::printf("  %-15s %8.1f us full sync %8.1f us unchanged | %zu entries\n", "Palette", tempFull, tempUnchanged, CommandPalette::g_live());
+
+	std::vector<uint32_t> tempResults;
+	std::string tempTyped;
+	for (const char* Ci = tempQuery; *Ci != '\0'; Ci++){
+		tempTyped += *Ci;
+		double tempWorst = 0.0;
+		double tempSum = 0.0;
+		for (int r = 0; r < tempRepeats; r++){
+			tempStart = std::chrono::steady_clock::now();
+			CommandPalette::search(tempTyped.c_str(), 12, tempResults);
+			const double tempTime = elapsed_us(tempStart);
+			tempSum += tempTime;
+			tempWorst = std::max(tempWorst, tempTime);
+		}
+		std::printf("  %-15s %8.1f us avg %8.1f max | \"%s\" -> %s\n", "", tempSum / tempRepeats, tempWorst, tempTyped.c_str(),
+			tempResults.empty() ? "-" : CommandPalette::g_entry(tempResults.front()).g_label());
+	}
+	CommandPalette::clear();
+}
+
+
+// The first contest caches the small pool, the second one grows the cache under it.
+// Both orders of the same two pools must agree, and every contest must sum to one.
+static bool check_contest_odds(){
+	const ContestResult tempSmallFirst = ContestOdds::g_odds(4, 9);
+	const ContestResult tempLargeFirst = ContestOdds::g_odds(9, 4);
+	const double tempSum = tempSmallFirst.win + tempSmallFirst.tie + tempSmallFirst.lose;
+	const bool tempOk = std::fabs(tempSmallFirst.win - tempLargeFirst.lose) < 1e-9 && std::fabs(tempSmallFirst.tie - tempLargeFirst.tie) < 1e-9
+		&& std::fabs(tempSmallFirst.lose - tempLargeFirst.win) < 1e-9 && std::fabs(tempSum - 1.0) < 1e-9;
+	std::printf("Contest odds 4 vs 9: win %.6f tie %.6f lose %.6f, %s\n", tempSmallFirst.win, tempSmallFirst.tie, tempSmallFirst.lose, tempOk ? "ok" : "MISMATCH");
+	return tempOk;
+}
+
+int main(int argc, char** argv){
+	if (!check_contest_odds()) return 1;
+	int tempArg = 1;
+	if (tempArg < argc && std::string(argv[tempArg]) == "--soft"){
+		softRaster = true;
+		tempArg++;
+	}
+	const int frames = tempArg < argc ? std::atoi(argv[tempArg]) : 2000;
+	std::vector<int> sizes;
+	for (int i = tempArg + 1; i < argc; i++) sizes.push_back(std::atoi(argv[i]));
+	if (sizes.empty()) sizes = {10, 100, 1000, 10000};
+
+	ImGui::SetAllocatorFunctions(imgui_alloc, imgui_free, nullptr);
+	GamePanels::init(nullptr);
+
+	for (const int& Ni : sizes){
+		ImGui::CreateContext();
+		ImGuiIO& io = ImGui::GetIO();
+		io.IniFilename = nullptr;
+		io.DisplaySize = {displayWidth, displayHeight};
+		if (softRaster){
+			ImGui_ImplSoft_Init();
+			ImGui_ImplSoft_CreateFontsTexture();
+			softPixels.resize(static_cast<size_t>(displayWidth) * static_cast<size_t>(displayHeight));
+		}
+		else {
+			unsigned char* tempPixels;
+			int tempWidth, tempHeight;
+			io.Fonts->GetTexDataAsAlpha8(&tempPixels, &tempWidth, &tempHeight);
+			io.Fonts->TexID = reinterpret_cast<ImTextureID>(static_cast<intptr_t>(1));
+		}
+		ImGui::StyleColorsDark();
+
+		const auto tempGenerateStart = std::chrono::steady_clock::now();
+		Scenario::generate({Ni / 10, Ni - Ni / 10, 1234, true});
+		std::printf("%zu actors, %i frames per panel, generated in %.1f ms\n", GamePanels::g_creatures().size(), frames, elapsed_us(tempGenerateStart) / 1000.0);
+		static const char* tempPhases[] = {"Manage Enemies", "Manage Players", "Game"};
+		static const char* tempScreenshots[] = {"enemies", "players", "game"};
+		for (int p = 0; p < 3; p++){
+			PhaseResult tempResult = run_phase(p, frames, "ui_bench_" + std::to_string(Ni) + "_" + tempScreenshots[p] + ".ppm");
+			report(tempPhases[p], tempResult);
+		}
+		bench_palette();
+		// Layouts refer to this context's font and draw list data.
+		TextLayout::clear();
+		if (softRaster) ImGui_ImplSoft_Shutdown();
+		ImGui::DestroyContext();
+	}
+	GamePanels::clear();
+	return 0;
+}
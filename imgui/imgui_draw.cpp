@@ -35,6 +35,12 @@ Index of this file:
 #include "imgui_internal.h"
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
+
+// SSE2 vertex writes for runs of ASCII text in ImFont::RenderText(), with the default ImDrawVert layout only
+#if !defined(IMGUI_DISABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_RENDERTEXT_SSE2
+#include <emmintrin.h>
+#endif
 #if !defined(alloca)
 #if defined(__GLIBC__) || defined(__sun) || defined(__APPLE__) || defined(__NEWLIB__)
 #include <alloca.h>     // alloca (glibc uses <alloca.h>. Note that Cygwin may have _WIN32 defined, so the order matters here)
@@ -3168,6 +3174,89 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     draw_list->PrimRectUV(ImVec2(pos.x + glyph->X0 * scale, pos.y + glyph->Y0 * scale), ImVec2(pos.x + glyph->X1 * scale, pos.y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
 }
 
+#ifdef IMGUI_RENDERTEXT_SSE2
+// Fast path of RenderText() for a run of printable ASCII characters without wrapping or fine clipping.
+// Glyphs are looked up 4 at a time, and each visible quad is written with vector stores: 5 for the 4 vertices (80 bytes), 2 for the 6 indices.
+// Positions are computed with the same operations and in the same order as the generic loop, so output is identical.
+// Returns the end of the run: the first character which isn't printable ASCII.
+static const char* ImFontRenderTextAsciiRun(const ImFont* font, float scale, float& x, float y, ImU32 col, const ImVec4& clip_rect, const char* s, const char* text_end, ImDrawVert*& vtx_write, ImDrawIdx*& idx_write, unsigned int& vtx_current_idx)
+{
+    IM_STATIC_ASSERT(sizeof(ImDrawVert) == 20 && IM_OFFSETOF(ImDrawVert, uv) == 8 && IM_OFFSETOF(ImDrawVert, col) == 16);
+    const ImFontGlyph* glyphs = font->Glyphs.Data;
+    const ImWchar* lookup = font->IndexLookup.Data;
+    const int lookup_size = font->IndexLookup.Size;
+    const ImFontGlyph* fallback = font->FallbackGlyph;
+    const __m128 v_scale = _mm_set1_ps(scale);
+    const __m128 v_col = _mm_castsi128_ps(_mm_set1_epi32((int)col));
+    const __m128 v_clip = _mm_set_ps(0.0f, clip_rect.x, 0.0f, clip_rect.z);    // compared against x1 (lane 0) and x2 (lane 2)
+    const __m128i idx_pattern = _mm_setr_epi16(0, 1, 2, 0, 2, 3, 0, 0);
+
+    ImDrawVert* vtx = vtx_write;
+    ImDrawIdx* idx = idx_write;
+    unsigned int vtx_idx = vtx_current_idx;
+    while (s < text_end)
+    {
+        // Batch lookup, stopping at the first character which isn't printable ASCII
+        const ImFontGlyph* batch[4];
+        int batch_size = 0;
+        for (; batch_size < 4 && s + batch_size < text_end; batch_size++)
+        {
+            const unsigned int c = (unsigned char)s[batch_size];
+            if (c < 32 || c >= 0x7F)
+                break;
+            const ImWchar i = (int)c < lookup_size ? lookup[c] : (ImWchar)-1;
+            batch[batch_size] = (i == (ImWchar)-1) ? fallback : &glyphs[i];
+        }
+        if (batch_size == 0)
+            break;
+        s += batch_size;
+
+        for (int n = 0; n < batch_size; n++)
+        {
+            const ImFontGlyph* glyph = batch[n];
+            if (glyph == NULL)
+                continue;
+            if (glyph->Visible)
+            {
+                // (x1, y1, x2, y2), then the horizontal clip test: x1 <= clip_rect.z && x2 >= clip_rect.x
+                const __m128 p = _mm_add_ps(_mm_set_ps(y, x, y, x), _mm_mul_ps(_mm_loadu_ps(&glyph->X0), v_scale));
+                if ((_mm_movemask_ps(_mm_cmple_ps(p, v_clip)) & 0x1) && (_mm_movemask_ps(_mm_cmpge_ps(p, v_clip)) & 0x4))
+                {
+                    const __m128 uv = _mm_loadu_ps(&glyph->U0);                                         // (u1, v1, u2, v2)
+                    float* dst = (float*)vtx;
+                    _mm_storeu_ps(dst + 0,  _mm_movelh_ps(p, uv));                                                                          // x1 y1 u1 v1
+                    _mm_storeu_ps(dst + 4,  _mm_shuffle_ps(_mm_shuffle_ps(v_col, p, _MM_SHUFFLE(2, 2, 0, 0)), _mm_shuffle_ps(p, uv, _MM_SHUFFLE(2, 2, 1, 1)), _MM_SHUFFLE(2, 0, 2, 0)));   // col x2 y1 u2
+                    _mm_storeu_ps(dst + 8,  _mm_shuffle_ps(_mm_shuffle_ps(uv, v_col, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0))); // v1 col x2 y2
+                    _mm_storeu_ps(dst + 12, _mm_shuffle_ps(_mm_shuffle_ps(uv, uv, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(v_col, p, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));  // u2 v2 col x1
+                    _mm_storeu_ps(dst + 16, _mm_shuffle_ps(_mm_shuffle_ps(p, uv, _MM_SHUFFLE(0, 0, 3, 3)), _mm_shuffle_ps(uv, v_col, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0))); // y2 u1 v2 col
+                    if (sizeof(ImDrawIdx) == 2)
+                    {
+                        // 0 1 2 0 | 2 3: one 8 bytes store and one 4 bytes store
+                        const __m128i i = _mm_add_epi16(_mm_set1_epi16((short)vtx_idx), idx_pattern);
+                        _mm_storel_epi64((__m128i*)idx, i);
+                        const int i23 = _mm_cvtsi128_si32(_mm_srli_si128(i, 8));
+                        memcpy(idx + 4, &i23, 4);
+                    }
+                    else
+                    {
+                        idx[0] = (ImDrawIdx)(vtx_idx); idx[1] = (ImDrawIdx)(vtx_idx+1); idx[2] = (ImDrawIdx)(vtx_idx+2);
+                        idx[3] = (ImDrawIdx)(vtx_idx); idx[4] = (ImDrawIdx)(vtx_idx+2); idx[5] = (ImDrawIdx)(vtx_idx+3);
+                    }
+                    vtx += 4;
+                    vtx_idx += 4;
+                    idx += 6;
+                }
+            }
+            x += glyph->AdvanceX * scale;
+        }
+    }
+    vtx_write = vtx;
+    idx_write = idx;
+    vtx_current_idx = vtx_idx;
+    return s;
+}
+#endif
+
 void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
 {
     if (!text_end)
@@ -3225,6 +3314,14 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
 
     while (s < text_end)
     {
+#ifdef IMGUI_RENDERTEXT_SSE2
+        if (!word_wrap_enabled && !cpu_fine_clip && (unsigned char)(*s - 32) < 0x5F)
+        {
+            s = ImFontRenderTextAsciiRun(this, scale, x, y, col, clip_rect, s, text_end, vtx_write, idx_write, vtx_current_idx);
+            if (s >= text_end)
+                break;
+        }
+#endif
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
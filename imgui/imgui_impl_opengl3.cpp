@@ -133,6 +133,19 @@ using namespace gl;
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.2+ has sync objects and glDrawElementsBaseVertex(), needed by the streaming fast path. Persistent mapping also needs glBufferStorage() (4.4 or GL_ARB_buffer_storage).
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_3_2)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_FAST_PATH
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#endif
+#endif
+
+// Desktop GL 4.1+ (or GL_ARB_get_program_binary) can save linked programs, see ImGui_ImplOpenGL3_SetShaderCachePath().
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && (defined(GL_VERSION_4_1) || defined(GL_ARB_get_program_binary))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+#endif
+
 // OpenGL Data
 static GLuint       g_GlVersion = 0;                // Extracted at runtime using GL_MAJOR_VERSION, GL_MINOR_VERSION queries (e.g. 320 for GL 3.2)
 static char         g_GlslVersionString[32] = "";   // Specified by user or detected based on compile time GL settings.
@@ -141,8 +154,50 @@ static GLuint       g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
 static GLint        g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;                                // Uniforms location
 static GLuint       g_AttribLocationVtxPos = 0, g_AttribLocationVtxUV = 0, g_AttribLocationVtxColor = 0; // Vertex attributes location
 static unsigned int g_VboHandle = 0, g_ElementsHandle = 0;
+static bool         g_FastPath = false, g_OwnContext = false; // See ImGui_ImplOpenGL3_SetFastPath()
+static bool         g_HasClipOverride = false;
+static char         g_ShaderCachePath[256] = "";            // See ImGui_ImplOpenGL3_SetShaderCachePath()
+static ImVec4       g_ClipOverride;                         // See ImGui_ImplOpenGL3_SetClipOverride()
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_FAST_PATH
+// Streaming ring for the fast path: one VAO, one VBO and one IBO split in RING_FRAMES regions of VtxCapacity/IdxCapacity elements.
+// Persistent: the regions stay mapped and are reused once their fence signals. Otherwise a single region is orphaned every frame.
+enum { RING_FRAMES = 3 };
+struct ImGui_ImplOpenGL3_Ring
+{
+    GLuint      Vao, Vbo, Ibo;
+    size_t      VtxCapacity, IdxCapacity;
+    char*       VtxMapped;
+    char*       IdxMapped;
+    GLsync      Fences[RING_FRAMES];
+    int         Frame;
+    bool        Persistent;
+};
+static ImGui_ImplOpenGL3_Ring g_Ring = {};
+static bool         g_HasBufferStorage = false;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+static bool         g_HasProgramBinary = false;
+#endif
 
 // Functions
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE) || defined(IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY)
+static bool ImGui_ImplOpenGL3_HasExtension(const char* name)
+{
+    if (g_GlVersion < 300)
+        return false;
+    GLint num_extensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
+    for (GLint i = 0; i < num_extensions; i++)
+    {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+        if (extension != NULL && strcmp(extension, name) == 0)
+            return true;
+    }
+    return false;
+}
+#endif
+
 bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 {
     // Query for GL version (e.g. 320 for GL 3.2)
@@ -213,6 +268,19 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     GLint current_texture;
     glGetIntegerv(GL_TEXTURE_BINDING_2D, &current_texture);
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    g_HasBufferStorage = g_GlVersion >= 440 || ImGui_ImplOpenGL3_HasExtension("GL_ARB_buffer_storage");
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    g_HasProgramBinary = g_GlVersion >= 410 || ImGui_ImplOpenGL3_HasExtension("GL_ARB_get_program_binary");
+    if (g_HasProgramBinary)
+    {
+        GLint num_formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+        g_HasProgramBinary = num_formats > 0;
+    }
+#endif
+
     return true;
 }
 
@@ -221,6 +289,27 @@ void    ImGui_ImplOpenGL3_Shutdown()
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 }
 
+void    ImGui_ImplOpenGL3_SetFastPath(bool enabled, bool own_context)
+{
+    g_FastPath = enabled;
+    g_OwnContext = enabled && own_context;
+}
+
+void    ImGui_ImplOpenGL3_SetShaderCachePath(const char* path)
+{
+    if (path == NULL)
+        path = "";
+    IM_ASSERT((int)strlen(path) < IM_ARRAYSIZE(g_ShaderCachePath));
+    strcpy(g_ShaderCachePath, path);
+}
+
+void    ImGui_ImplOpenGL3_SetClipOverride(const ImVec4* clip_rect)
+{
+    g_HasClipOverride = clip_rect != NULL;
+    if (clip_rect)
+        g_ClipOverride = *clip_rect;
+}
+
 void    ImGui_ImplOpenGL3_NewFrame()
 {
     if (!g_ShaderHandle)
@@ -276,6 +365,10 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 #ifndef IMGUI_IMPL_OPENGL_ES2
     glBindVertexArray(vertex_array_object);
 #endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_FAST_PATH
+    if (vertex_array_object != 0 && vertex_array_object == g_Ring.Vao)
+        return; // Buffers and attributes are already part of the cached VAO
+#endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
     glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
@@ -288,6 +381,206 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glVertexAttribPointer(g_AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_FAST_PATH
+static void ImGui_ImplOpenGL3_DestroyRing()
+{
+    for (int i = 0; i < RING_FRAMES; i++)
+        if (g_Ring.Fences[i])
+            glDeleteSync(g_Ring.Fences[i]);
+    // Deleting the buffers also unmaps them
+    if (g_Ring.Vbo) glDeleteBuffers(1, &g_Ring.Vbo);
+    if (g_Ring.Ibo) glDeleteBuffers(1, &g_Ring.Ibo);
+    if (g_Ring.Vao) glDeleteVertexArrays(1, &g_Ring.Vao);
+    memset(&g_Ring, 0, sizeof(g_Ring));
+}
+
+static void ImGui_ImplOpenGL3_CreateRing(size_t vtx_capacity, size_t idx_capacity)
+{
+    g_Ring.VtxCapacity = vtx_capacity;
+    g_Ring.IdxCapacity = idx_capacity;
+    const GLsizeiptr vtx_bytes = (GLsizeiptr)(vtx_capacity * sizeof(ImDrawVert));
+    const GLsizeiptr idx_bytes = (GLsizeiptr)(idx_capacity * sizeof(ImDrawIdx));
+    glGenVertexArrays(1, &g_Ring.Vao);
+    glBindVertexArray(g_Ring.Vao);
+    glGenBuffers(1, &g_Ring.Vbo);
+    glGenBuffers(1, &g_Ring.Ibo);
+    glBindBuffer(GL_ARRAY_BUFFER, g_Ring.Vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_Ring.Ibo);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (g_HasBufferStorage)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, vtx_bytes * RING_FRAMES, NULL, flags);
+        glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, idx_bytes * RING_FRAMES, NULL, flags);
+        g_Ring.VtxMapped = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vtx_bytes * RING_FRAMES, flags);
+        g_Ring.IdxMapped = (char*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, idx_bytes * RING_FRAMES, flags);
+        g_Ring.Persistent = g_Ring.VtxMapped != NULL && g_Ring.IdxMapped != NULL;
+        if (!g_Ring.Persistent)
+        {
+            // Immutable storage can't be respecified, start over with plain buffers
+            g_HasBufferStorage = false;
+            ImGui_ImplOpenGL3_DestroyRing();
+            ImGui_ImplOpenGL3_CreateRing(vtx_capacity, idx_capacity);
+            return;
+        }
+    }
+#endif
+    if (!g_Ring.Persistent)
+    {
+        glBufferData(GL_ARRAY_BUFFER, vtx_bytes, NULL, GL_STREAM_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_bytes, NULL, GL_STREAM_DRAW);
+    }
+    glEnableVertexAttribArray(g_AttribLocationVtxPos);
+    glEnableVertexAttribArray(g_AttribLocationVtxUV);
+    glEnableVertexAttribArray(g_AttribLocationVtxColor);
+    glVertexAttribPointer(g_AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
+    glVertexAttribPointer(g_AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
+    glVertexAttribPointer(g_AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+}
+
+// Copy the whole frame into the next ring region, in command list order. Outputs the element offsets of that region.
+static bool ImGui_ImplOpenGL3_UploadRing(ImDrawData* draw_data, size_t* vtx_base, size_t* idx_base)
+{
+    if (!g_FastPath || g_GlVersion < 320)
+    {
+        if (g_Ring.Vao)
+            ImGui_ImplOpenGL3_DestroyRing();
+        return false;
+    }
+    const size_t vtx_needed = (size_t)draw_data->TotalVtxCount;
+    const size_t idx_needed = (size_t)draw_data->TotalIdxCount;
+    if (!g_Ring.Vao || vtx_needed > g_Ring.VtxCapacity || idx_needed > g_Ring.IdxCapacity)
+    {
+        size_t vtx_capacity = g_Ring.VtxCapacity ? g_Ring.VtxCapacity : 1 << 16;
+        size_t idx_capacity = g_Ring.IdxCapacity ? g_Ring.IdxCapacity : 1 << 17;
+        while (vtx_capacity < vtx_needed) vtx_capacity *= 2;
+        while (idx_capacity < idx_needed) idx_capacity *= 2;
+        if (g_Ring.Vao)
+            glFinish(); // Regions still read by the GPU go away with the old buffers
+        ImGui_ImplOpenGL3_DestroyRing();
+        ImGui_ImplOpenGL3_CreateRing(vtx_capacity, idx_capacity);
+    }
+
+    char* vtx_dst;
+    char* idx_dst;
+    glBindVertexArray(g_Ring.Vao);
+    if (g_Ring.Persistent)
+    {
+        const int region = g_Ring.Frame % RING_FRAMES;
+        if (g_Ring.Fences[region])
+        {
+            glClientWaitSync(g_Ring.Fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, (GLuint64)1000000000);
+            glDeleteSync(g_Ring.Fences[region]);
+            g_Ring.Fences[region] = 0;
+        }
+        *vtx_base = region * g_Ring.VtxCapacity;
+        *idx_base = region * g_Ring.IdxCapacity;
+        vtx_dst = g_Ring.VtxMapped + *vtx_base * sizeof(ImDrawVert);
+        idx_dst = g_Ring.IdxMapped + *idx_base * sizeof(ImDrawIdx);
+    }
+    else
+    {
+        // Orphan: the driver hands out fresh storage while the previous frame is still in flight
+        *vtx_base = *idx_base = 0;
+        if (vtx_needed == 0 || idx_needed == 0)
+            return true;
+        glBindBuffer(GL_ARRAY_BUFFER, g_Ring.Vbo);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(g_Ring.VtxCapacity * sizeof(ImDrawVert)), NULL, GL_STREAM_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(g_Ring.IdxCapacity * sizeof(ImDrawIdx)), NULL, GL_STREAM_DRAW);
+        vtx_dst = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)(vtx_needed * sizeof(ImDrawVert)), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        idx_dst = (char*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, (GLsizeiptr)(idx_needed * sizeof(ImDrawIdx)), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    }
+
+    for (int n = 0; n < draw_data->CmdListsCount && vtx_dst && idx_dst; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        memcpy(vtx_dst, cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        memcpy(idx_dst, cmd_list->IdxBuffer.Data, (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        vtx_dst += (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+        idx_dst += (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+    }
+
+    if (!g_Ring.Persistent)
+    {
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+    }
+    return true;
+}
+#endif
+
+struct ImGui_ImplOpenGL3_StateBackup
+{
+    GLenum      last_active_texture;
+    GLuint      last_program;
+    GLuint      last_texture;
+    GLuint      last_sampler;
+    GLuint      last_array_buffer;
+    GLuint      last_vertex_array_object;
+    GLint       last_polygon_mode[2];
+    GLint       last_viewport[4];
+    GLint       last_scissor_box[4];
+    GLenum      last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha;
+    GLenum      last_blend_equation_rgb, last_blend_equation_alpha;
+    GLboolean   last_enable_blend, last_enable_cull_face, last_enable_depth_test, last_enable_scissor_test;
+};
+
+static void ImGui_ImplOpenGL3_BackupState(ImGui_ImplOpenGL3_StateBackup* b)
+{
+    glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&b->last_active_texture);
+    glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&b->last_program);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&b->last_texture);
+    b->last_sampler = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+    if (g_GlVersion >= 330) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&b->last_sampler); }
+#endif
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&b->last_array_buffer);
+#ifndef IMGUI_IMPL_OPENGL_ES2
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&b->last_vertex_array_object);
+#endif
+#ifdef GL_POLYGON_MODE
+    glGetIntegerv(GL_POLYGON_MODE, b->last_polygon_mode);
+#endif
+    glGetIntegerv(GL_VIEWPORT, b->last_viewport);
+    glGetIntegerv(GL_SCISSOR_BOX, b->last_scissor_box);
+    glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&b->last_blend_src_rgb);
+    glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&b->last_blend_dst_rgb);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&b->last_blend_src_alpha);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&b->last_blend_dst_alpha);
+    glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&b->last_blend_equation_rgb);
+    glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&b->last_blend_equation_alpha);
+    b->last_enable_blend = glIsEnabled(GL_BLEND);
+    b->last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
+    b->last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
+    b->last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+}
+
+static void ImGui_ImplOpenGL3_RestoreState(const ImGui_ImplOpenGL3_StateBackup* b)
+{
+    glUseProgram(b->last_program);
+    glBindTexture(GL_TEXTURE_2D, b->last_texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+    if (g_GlVersion >= 330)
+        glBindSampler(0, b->last_sampler);
+#endif
+    glActiveTexture(b->last_active_texture);
+#ifndef IMGUI_IMPL_OPENGL_ES2
+    glBindVertexArray(b->last_vertex_array_object);
+#endif
+    glBindBuffer(GL_ARRAY_BUFFER, b->last_array_buffer);
+    glBlendEquationSeparate(b->last_blend_equation_rgb, b->last_blend_equation_alpha);
+    glBlendFuncSeparate(b->last_blend_src_rgb, b->last_blend_dst_rgb, b->last_blend_src_alpha, b->last_blend_dst_alpha);
+    if (b->last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+    if (b->last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
+    if (b->last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+    if (b->last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
+#ifdef GL_POLYGON_MODE
+    glPolygonMode(GL_FRONT_AND_BACK, (GLenum)b->last_polygon_mode[0]);
+#endif
+    glViewport(b->last_viewport[0], b->last_viewport[1], (GLsizei)b->last_viewport[2], (GLsizei)b->last_viewport[3]);
+    glScissor(b->last_scissor_box[0], b->last_scissor_box[1], (GLsizei)b->last_scissor_box[2], (GLsizei)b->last_scissor_box[3]);
+}
+
 // OpenGL3 Render function.
 // (this used to be set in io.RenderDrawListsFn and called by ImGui::Render(), but you can now call this directly from your main loop)
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly, in order to be able to run within any OpenGL engine that doesn't do so.
@@ -299,40 +592,27 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     if (fb_width <= 0 || fb_height <= 0)
         return;
 
-    // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
+    // Backup GL state (skipped when the application leaves the GL context to us, see ImGui_ImplOpenGL3_SetFastPath())
+    ImGui_ImplOpenGL3_StateBackup backup;
+    if (!g_OwnContext)
+        ImGui_ImplOpenGL3_BackupState(&backup);
     glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (g_GlVersion >= 330) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
-#endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_ES2
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
-#endif
-#ifdef GL_POLYGON_MODE
-    GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
 
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
+    // The fast path draws the whole frame from one upload into the streaming ring, through its cached VAO.
     GLuint vertex_array_object = 0;
+    size_t ring_vtx_offset = 0, ring_idx_offset = 0;
+    bool use_ring = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_FAST_PATH
+    use_ring = ImGui_ImplOpenGL3_UploadRing(draw_data, &ring_vtx_offset, &ring_idx_offset);
+    if (use_ring)
+        vertex_array_object = g_Ring.Vao;
+#endif
 #ifndef IMGUI_IMPL_OPENGL_ES2
-    glGenVertexArrays(1, &vertex_array_object);
+    if (!use_ring)
+        glGenVertexArrays(1, &vertex_array_object);
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
@@ -346,8 +626,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
 
         // Upload vertex/index buffers
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        if (!use_ring)
+        {
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        }
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -364,13 +647,21 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             else
             {
                 // Project scissor/clipping rectangles into framebuffer space
+                ImVec4 cmd_clip_rect = pcmd->ClipRect;
+                if (g_HasClipOverride)
+                {
+                    if (cmd_clip_rect.x < g_ClipOverride.x) cmd_clip_rect.x = g_ClipOverride.x;
+                    if (cmd_clip_rect.y < g_ClipOverride.y) cmd_clip_rect.y = g_ClipOverride.y;
+                    if (cmd_clip_rect.z > g_ClipOverride.z) cmd_clip_rect.z = g_ClipOverride.z;
+                    if (cmd_clip_rect.w > g_ClipOverride.w) cmd_clip_rect.w = g_ClipOverride.w;
+                }
                 ImVec4 clip_rect;
-                clip_rect.x = (pcmd->ClipRect.x - clip_off.x) * clip_scale.x;
-                clip_rect.y = (pcmd->ClipRect.y - clip_off.y) * clip_scale.y;
-                clip_rect.z = (pcmd->ClipRect.z - clip_off.x) * clip_scale.x;
-                clip_rect.w = (pcmd->ClipRect.w - clip_off.y) * clip_scale.y;
+                clip_rect.x = (cmd_clip_rect.x - clip_off.x) * clip_scale.x;
+                clip_rect.y = (cmd_clip_rect.y - clip_off.y) * clip_scale.y;
+                clip_rect.z = (cmd_clip_rect.z - clip_off.x) * clip_scale.x;
+                clip_rect.w = (cmd_clip_rect.w - clip_off.y) * clip_scale.y;
 
-                if (clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f)
+                if (clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f && clip_rect.z > clip_rect.x && clip_rect.w > clip_rect.y)
                 {
                     // Apply scissor/clipping rectangle
                     glScissor((int)clip_rect.x, (int)(fb_height - clip_rect.w), (int)(clip_rect.z - clip_rect.x), (int)(clip_rect.w - clip_rect.y));
@@ -379,43 +670,40 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                     if (g_GlVersion >= 320)
-                        glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
+                        glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)((ring_idx_offset + pcmd->IdxOffset) * sizeof(ImDrawIdx)), (GLint)(ring_vtx_offset + pcmd->VtxOffset));
                     else
 #endif
                     glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
                 }
             }
         }
+        if (use_ring)
+        {
+            ring_vtx_offset += (size_t)cmd_list->VtxBuffer.Size;
+            ring_idx_offset += (size_t)cmd_list->IdxBuffer.Size;
+        }
     }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_FAST_PATH
+    // Fence the region just drawn from, it is written again RING_FRAMES frames later
+    if (use_ring && g_Ring.Persistent)
+    {
+        g_Ring.Fences[g_Ring.Frame % RING_FRAMES] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        g_Ring.Frame++;
+    }
+#endif
+
     // Destroy the temporary VAO
 #ifndef IMGUI_IMPL_OPENGL_ES2
-    glDeleteVertexArrays(1, &vertex_array_object);
+    if (!use_ring)
+        glDeleteVertexArrays(1, &vertex_array_object);
 #endif
 
     // Restore modified GL state
-    glUseProgram(last_program);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    if (g_GlVersion >= 330)
-        glBindSampler(0, last_sampler);
-#endif
-    glActiveTexture(last_active_texture);
-#ifndef IMGUI_IMPL_OPENGL_ES2
-    glBindVertexArray(last_vertex_array_object);
-#endif
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-    glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-    glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
-    if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-    if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-    if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-    if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
-#ifdef GL_POLYGON_MODE
-    glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
-#endif
-    glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
-    glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+    if (!g_OwnContext)
+        ImGui_ImplOpenGL3_RestoreState(&backup);
+    else
+        glDisable(GL_SCISSOR_TEST); // So the application's next glClear() still covers the whole framebuffer
 }
 
 bool ImGui_ImplOpenGL3_CreateFontsTexture()
@@ -494,6 +782,84 @@ static bool CheckProgram(GLuint handle, const char* desc)
     return (GLboolean)status == GL_TRUE;
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+// Shader cache file: "IGPB", key length, key, binary format, binary length, binary.
+// The key holds the driver strings and a hash of the sources, any mismatch means a rebuild.
+static void ImGui_ImplOpenGL3_ShaderCacheKey(ImVector<char>* key, const GLchar* vertex_shader, const GLchar* fragment_shader)
+{
+    ImU64 hash = 0xCBF29CE484222325ull;
+    const GLchar* sources[3] = { g_GlslVersionString, vertex_shader, fragment_shader };
+    for (int i = 0; i < 3; i++)
+        for (const GLchar* c = sources[i]; *c; c++)
+            hash = (hash ^ (unsigned char)*c) * 0x100000001B3ull;
+    char buf[1024];
+    int len = snprintf(buf, sizeof(buf), "%s\n%s\n%s\n%016llx", (const char*)glGetString(GL_VENDOR), (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION), (unsigned long long)hash);
+    if (len < 0)
+        len = 0;
+    if (len >= (int)sizeof(buf))
+        len = (int)sizeof(buf) - 1;
+    key->resize(len);
+    memcpy(key->Data, buf, (size_t)len);
+}
+
+static GLuint ImGui_ImplOpenGL3_LoadProgramBinary(const ImVector<char>& key)
+{
+    FILE* f = fopen(g_ShaderCachePath, "rb");
+    if (!f)
+        return 0;
+    char magic[4];
+    ImU32 key_len = 0, format = 0, binary_len = 0;
+    ImVector<char> file_key, binary;
+    bool ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, "IGPB", 4) == 0 && fread(&key_len, sizeof(key_len), 1, f) == 1 && key_len == (ImU32)key.Size;
+    if (ok)
+    {
+        file_key.resize((int)key_len);
+        ok = fread(file_key.Data, 1, key_len, f) == key_len && memcmp(file_key.Data, key.Data, key_len) == 0;
+    }
+    ok = ok && fread(&format, sizeof(format), 1, f) == 1 && fread(&binary_len, sizeof(binary_len), 1, f) == 1 && binary_len > 0 && binary_len < (1u << 26);
+    if (ok)
+    {
+        binary.resize((int)binary_len);
+        ok = fread(binary.Data, 1, binary_len, f) == binary_len;
+    }
+    fclose(f);
+    if (!ok)
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum)format, binary.Data, (GLsizei)binary_len);
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if ((GLboolean)status == GL_TRUE)
+        return program;
+    glDeleteProgram(program); // Driver rejected it (e.g. updated in place), rebuild from source
+    return 0;
+}
+
+static void ImGui_ImplOpenGL3_SaveProgramBinary(GLuint program, const ImVector<char>& key)
+{
+    GLint binary_len = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_len);
+    if (binary_len <= 0)
+        return;
+    ImVector<char> binary;
+    binary.resize(binary_len);
+    GLenum format = 0;
+    glGetProgramBinary(program, binary_len, &binary_len, &format, binary.Data);
+    FILE* f = fopen(g_ShaderCachePath, "wb");
+    if (!f)
+        return;
+    const ImU32 key_len = (ImU32)key.Size, format_u32 = (ImU32)format, binary_len_u32 = (ImU32)binary_len;
+    fwrite("IGPB", 1, 4, f);
+    fwrite(&key_len, sizeof(key_len), 1, f);
+    fwrite(key.Data, 1, key_len, f);
+    fwrite(&format_u32, sizeof(format_u32), 1, f);
+    fwrite(&binary_len_u32, sizeof(binary_len_u32), 1, f);
+    fwrite(binary.Data, 1, (size_t)binary_len, f);
+    fclose(f);
+}
+#endif
+
 bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 {
     // Backup GL state
@@ -633,24 +999,47 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         fragment_shader = fragment_shader_glsl_130;
     }
 
+    // Load the linked program from the cache when it was saved by the same driver from the same sources
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    const bool use_cache = g_HasProgramBinary && g_ShaderCachePath[0] != 0;
+    ImVector<char> cache_key;
+    if (use_cache)
+    {
+        ImGui_ImplOpenGL3_ShaderCacheKey(&cache_key, vertex_shader, fragment_shader);
+        g_ShaderHandle = ImGui_ImplOpenGL3_LoadProgramBinary(cache_key);
+    }
+#endif
+
     // Create shaders
-    const GLchar* vertex_shader_with_version[2] = { g_GlslVersionString, vertex_shader };
-    g_VertHandle = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(g_VertHandle, 2, vertex_shader_with_version, NULL);
-    glCompileShader(g_VertHandle);
-    CheckShader(g_VertHandle, "vertex shader");
-
-    const GLchar* fragment_shader_with_version[2] = { g_GlslVersionString, fragment_shader };
-    g_FragHandle = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(g_FragHandle, 2, fragment_shader_with_version, NULL);
-    glCompileShader(g_FragHandle);
-    CheckShader(g_FragHandle, "fragment shader");
-
-    g_ShaderHandle = glCreateProgram();
-    glAttachShader(g_ShaderHandle, g_VertHandle);
-    glAttachShader(g_ShaderHandle, g_FragHandle);
-    glLinkProgram(g_ShaderHandle);
-    CheckProgram(g_ShaderHandle, "shader program");
+    if (!g_ShaderHandle)
+    {
+        const GLchar* vertex_shader_with_version[2] = { g_GlslVersionString, vertex_shader };
+        g_VertHandle = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(g_VertHandle, 2, vertex_shader_with_version, NULL);
+        glCompileShader(g_VertHandle);
+        CheckShader(g_VertHandle, "vertex shader");
+
+        const GLchar* fragment_shader_with_version[2] = { g_GlslVersionString, fragment_shader };
+        g_FragHandle = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(g_FragHandle, 2, fragment_shader_with_version, NULL);
+        glCompileShader(g_FragHandle);
+        CheckShader(g_FragHandle, "fragment shader");
+
+        g_ShaderHandle = glCreateProgram();
+        glAttachShader(g_ShaderHandle, g_VertHandle);
+        glAttachShader(g_ShaderHandle, g_FragHandle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (use_cache)
+            glProgramParameteri(g_ShaderHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+        glLinkProgram(g_ShaderHandle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (CheckProgram(g_ShaderHandle, "shader program") && use_cache)
+            ImGui_ImplOpenGL3_SaveProgramBinary(g_ShaderHandle, cache_key);
+#else
+        CheckProgram(g_ShaderHandle, "shader program");
+#endif
+    }
 
     g_AttribLocationTex = glGetUniformLocation(g_ShaderHandle, "Texture");
     g_AttribLocationProjMtx = glGetUniformLocation(g_ShaderHandle, "ProjMtx");
@@ -676,6 +1065,9 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
 void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_FAST_PATH
+    ImGui_ImplOpenGL3_DestroyRing();
+#endif
     if (g_VboHandle)        { glDeleteBuffers(1, &g_VboHandle); g_VboHandle = 0; }
     if (g_ElementsHandle)   { glDeleteBuffers(1, &g_ElementsHandle); g_ElementsHandle = 0; }
     if (g_ShaderHandle && g_VertHandle) { glDetachShader(g_ShaderHandle, g_VertHandle); }
@@ -30,6 +30,21 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_Shutdown();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_NewFrame();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data);
 
+// (Optional) Streaming fast path, off by default. Desktop GL 3.2+ only, ignored otherwise.
+// - Each frame is uploaded once into a triple-buffered ring drawn through a cached VAO: persistently mapped and fenced
+//   with GL 4.4 / GL_ARB_buffer_storage, orphaned every frame otherwise.
+// - 'own_context': skip saving/restoring the GL state around RenderDrawData (only the scissor test is switched back off).
+//   Only if nothing else relies on that state.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetFastPath(bool enabled, bool own_context = false);
+
+// (Optional) Intersect every draw command clip rectangle with 'clip_rect' (same space as ImDrawCmd::ClipRect), to redraw only part
+// of a retained framebuffer. Pass NULL to disable.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetClipOverride(const ImVec4* clip_rect);
+
+// (Optional) Keep the linked shader program in 'path' (glGetProgramBinary) and load it from there when the driver strings and
+// shader sources still match, instead of compiling. Desktop GL 4.1+ or GL_ARB_get_program_binary. Call before the first NewFrame().
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetShaderCachePath(const char* path);
+
 // (Optional) Called by Init/NewFrame/Shutdown
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateFontsTexture();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
@@ -0,0 +1,527 @@
+// dear imgui: Renderer for the CPU, rasterizing into an in-memory RGBA buffer
+// - No GPU or graphics API: for screenshot tests and benchmarks on headless machines.
+// This needs to be used along with a Platform Binding, or with inputs fed by hand (e.g. a headless test driver).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoft_Texture*' as ImTextureID.
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Scissor clipping, alpha blending (SRC_ALPHA, ONE_MINUS_SRC_ALPHA), textures sampled nearest and clamped.
+//  [X] Renderer: Tiled edge function rasterization, 4 pixels at a time with SSE2 (scalar fallback), tiles spread over worker threads.
+
+// How it works:
+// - Every triangle is set up once per frame (clipped bounds, attribute gradients) and appended to the bin of every
+//   TILE_SIZE x TILE_SIZE tile its bounds touch. Bins keep submission order, so blending order is the same as on a GPU.
+// - Tiles are independent: the calling thread and the workers take them from a shared counter until none are left.
+// - Edge functions are evaluated at pixel centers from vertices relative to the tile origin. Two triangles sharing an
+//   edge evaluate it to exactly opposite values, and ties go to top-left edges, so no pixel is drawn twice or missed.
+// - Colors and UVs are interpolated from the first vertex, which keeps them precise far from the origin.
+//   With ImGui's pixel aligned glyphs, nearest sampling matches the GL backend's linear filtering at texel centers.
+
+#include "imgui.h"
+#include "imgui_impl_soft.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMGUI_IMPL_SOFT_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+enum { TILE_SIZE = 64 };
+
+struct ImGui_ImplSoft_Triangle
+{
+    ImVec2          Pos[3];
+    float           EdgeA[3], EdgeB[3];     // Edge i runs between vertices i+1 and i+2, positive inside whatever the winding
+    float           Sign;                   // Winding, applied to the per tile edge constants
+    bool            TopLeft[3];
+    float           Attr[6], AttrDx[6], AttrDy[6];  // R, G, B, A (0..255), U, V at Pos[0] and their gradients
+    int             MinX, MinY, MaxX, MaxY; // Pixel bounds, clipped, max exclusive
+    const ImGui_ImplSoft_Texture* Texture;
+    bool            ConstantColor;
+    bool            ConstantUv;
+    ImU32           Texel;                  // Texel under a constant UV
+    bool            Flat;                   // Constant color and UV: one source for the whole triangle
+    bool            Opaque;                 // Flat and fully opaque: pixels are overwritten with 'OpaqueColor'
+    ImU32           OpaqueColor;
+    float           Premul[4], InvAlpha;    // Flat source, see ImGui_ImplSoft_Source()
+};
+
+static ImGui_ImplSoft_Texture           g_FontTexture = {};
+static ImVector<ImU32>                  g_FontPixels;
+static ImVector<ImGui_ImplSoft_Triangle> g_Triangles;
+static std::vector<ImVector<int> >      g_Bins;
+static int          g_TilesX = 0, g_TilesY = 0;
+static ImU32*       g_Target = NULL;
+static int          g_TargetWidth = 0, g_TargetHeight = 0;   // Drawn area, clamped to the framebuffer
+static int          g_TargetStride = 0;                     // Pixels between rows, the caller's 'width'
+
+// Worker threads, woken once per RenderDrawData() call
+static std::vector<std::thread> g_Workers;
+static std::mutex               g_WorkersMutex;
+static std::condition_variable  g_WorkersWake, g_WorkersDone;
+static unsigned int             g_WorkersGeneration = 0;
+static int                      g_WorkersRunning = 0;
+static bool                     g_WorkersQuit = false;
+static std::atomic<int>         g_NextTile(0);
+
+static void ImGui_ImplSoft_RenderTiles();
+
+static void ImGui_ImplSoft_WorkerLoop()
+{
+    unsigned int generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(g_WorkersMutex);
+            g_WorkersWake.wait(lock, [&]() { return g_WorkersQuit || g_WorkersGeneration != generation; });
+            if (g_WorkersQuit)
+                return;
+            generation = g_WorkersGeneration;
+        }
+        ImGui_ImplSoft_RenderTiles();
+        {
+            std::lock_guard<std::mutex> lock(g_WorkersMutex);
+            g_WorkersRunning--;
+        }
+        g_WorkersDone.notify_one();
+    }
+}
+
+bool    ImGui_ImplSoft_Init(int threads)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererName = "imgui_impl_soft";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+
+    if (threads < 0)
+    {
+        const int hardware = (int)std::thread::hardware_concurrency();
+        threads = hardware > 1 ? hardware - 1 : 0;
+    }
+    g_WorkersQuit = false;
+    for (int n = 0; n < threads; n++)
+        g_Workers.push_back(std::thread(ImGui_ImplSoft_WorkerLoop));
+    return true;
+}
+
+void    ImGui_ImplSoft_Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_WorkersMutex);
+        g_WorkersQuit = true;
+    }
+    g_WorkersWake.notify_all();
+    for (size_t n = 0; n < g_Workers.size(); n++)
+        g_Workers[n].join();
+    g_Workers.clear();
+    ImGui_ImplSoft_DestroyFontsTexture();
+    g_Triangles.clear();
+    g_Bins.clear();
+}
+
+void    ImGui_ImplSoft_NewFrame()
+{
+    if (g_FontTexture.Pixels == NULL)
+        ImGui_ImplSoft_CreateFontsTexture();
+}
+
+bool    ImGui_ImplSoft_CreateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    g_FontPixels.resize(width * height);
+    memcpy(g_FontPixels.Data, pixels, (size_t)width * height * sizeof(ImU32));
+    g_FontTexture.Width = width;
+    g_FontTexture.Height = height;
+    g_FontTexture.Pixels = g_FontPixels.Data;
+    io.Fonts->TexID = (ImTextureID)&g_FontTexture;
+    return true;
+}
+
+void    ImGui_ImplSoft_DestroyFontsTexture()
+{
+    if (g_FontTexture.Pixels == NULL)
+        return;
+    ImGui::GetIO().Fonts->TexID = 0;
+    g_FontPixels.clear();
+    g_FontTexture = ImGui_ImplSoft_Texture();
+}
+
+static inline ImU32 ImGui_ImplSoft_Sample(const ImGui_ImplSoft_Texture* tex, float u, float v)
+{
+    int x = (int)(u * tex->Width);
+    int y = (int)(v * tex->Height);
+    x = x < 0 ? 0 : (x >= tex->Width ? tex->Width - 1 : x);
+    y = y < 0 ? 0 : (y >= tex->Height ? tex->Height - 1 : y);
+    return tex->Pixels[y * tex->Width + x];
+}
+
+// Source = color * texel, premultiplied by its alpha for dst = src * src.a + dst * (1 - src.a) on all four channels.
+// Returns false when the source is invisible.
+static inline bool ImGui_ImplSoft_Source(const float* color, ImU32 texel, float* premul, float* inv_alpha)
+{
+    float src[4];
+    for (int c = 0; c < 4; c++)
+        src[c] = color[c] * (float)((texel >> (c * 8)) & 0xFF) * (1.0f / 255.0f);
+    const float alpha = src[3] * (1.0f / 255.0f);
+    for (int c = 0; c < 4; c++)
+        premul[c] = src[c] * alpha;
+    *inv_alpha = 1.0f - alpha;
+    return alpha > 0.0f;
+}
+
+static inline void ImGui_ImplSoft_Blend(ImU32* dst, const float* premul, float inv_alpha)
+{
+#ifdef IMGUI_IMPL_SOFT_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 d = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)*dst), zero), zero));
+    __m128 r = _mm_add_ps(_mm_loadu_ps(premul), _mm_mul_ps(d, _mm_set1_ps(inv_alpha)));
+    r = _mm_min_ps(_mm_max_ps(r, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    const __m128i ri = _mm_cvtps_epi32(r);
+    *dst = (ImU32)_mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(ri, zero), zero));
+#else
+    ImU32 out = 0;
+    for (int c = 0; c < 4; c++)
+    {
+        float r = premul[c] + (float)((*dst >> (c * 8)) & 0xFF) * inv_alpha;
+        r = r < 0.0f ? 0.0f : (r > 255.0f ? 255.0f : r);
+        out |= (ImU32)(int)(r + 0.5f) << (c * 8);
+    }
+    *dst = out;
+#endif
+}
+
+#ifdef IMGUI_IMPL_SOFT_HAS_SSE2
+// Four covered pixels of a flat triangle at once, same arithmetic as ImGui_ImplSoft_Blend().
+static inline void ImGui_ImplSoft_Blend4(ImU32* dst, __m128 premul, __m128 inv_alpha)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i d = _mm_loadu_si128((const __m128i*)dst);
+    const __m128i lo = _mm_unpacklo_epi8(d, zero), hi = _mm_unpackhi_epi8(d, zero);
+    const __m128i px[4] = { _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero), _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero) };
+    __m128i out[4];
+    for (int n = 0; n < 4; n++)
+    {
+        __m128 r = _mm_add_ps(premul, _mm_mul_ps(_mm_cvtepi32_ps(px[n]), inv_alpha));
+        r = _mm_min_ps(_mm_max_ps(r, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+        out[n] = _mm_cvtps_epi32(r);
+    }
+    _mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(_mm_packs_epi32(out[0], out[1]), _mm_packs_epi32(out[2], out[3])));
+}
+#endif
+
+static inline void ImGui_ImplSoft_ShadePixel(const ImGui_ImplSoft_Triangle& tri, ImU32* dst, float px, float py)
+{
+    if (tri.Flat)
+    {
+        if (tri.Opaque)
+            *dst = tri.OpaqueColor;
+        else
+            ImGui_ImplSoft_Blend(dst, tri.Premul, tri.InvAlpha);
+        return;
+    }
+    const float dx = px - tri.Pos[0].x, dy = py - tri.Pos[0].y;
+    float color[4];
+    for (int c = 0; c < 4; c++)
+        color[c] = tri.ConstantColor ? tri.Attr[c] : tri.Attr[c] + tri.AttrDx[c] * dx + tri.AttrDy[c] * dy;
+    const ImU32 texel = tri.ConstantUv ? tri.Texel : ImGui_ImplSoft_Sample(tri.Texture, tri.Attr[4] + tri.AttrDx[4] * dx + tri.AttrDy[4] * dy, tri.Attr[5] + tri.AttrDx[5] * dx + tri.AttrDy[5] * dy);
+    float premul[4], inv_alpha;
+    if (ImGui_ImplSoft_Source(color, texel, premul, &inv_alpha))
+        ImGui_ImplSoft_Blend(dst, premul, inv_alpha);
+}
+
+static void ImGui_ImplSoft_RasterizeInTile(const ImGui_ImplSoft_Triangle& tri, int tile_x0, int tile_y0)
+{
+    const int x0 = std::max(tri.MinX, tile_x0), x1 = std::min(tri.MaxX, std::min(tile_x0 + (int)TILE_SIZE, g_TargetWidth));
+    const int y0 = std::max(tri.MinY, tile_y0), y1 = std::min(tri.MaxY, std::min(tile_y0 + (int)TILE_SIZE, g_TargetHeight));
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    // Edge constants relative to the tile origin (exact subtractions), evaluated at local pixel centers.
+    float edge_c[3];
+    for (int e = 0; e < 3; e++)
+    {
+        const ImVec2& a = tri.Pos[(e + 1) % 3];
+        const ImVec2& b = tri.Pos[(e + 2) % 3];
+        const float ax = a.x - (float)tile_x0, ay = a.y - (float)tile_y0, bx = b.x - (float)tile_x0, by = b.y - (float)tile_y0;
+        edge_c[e] = (ax * by - ay * bx) * tri.Sign;
+    }
+
+#ifdef IMGUI_IMPL_SOFT_HAS_SSE2
+    const int xs = tile_x0 + ((x0 - tile_x0) & ~3);
+    const __m128 lane = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 ea[3], tl[3];
+    for (int e = 0; e < 3; e++)
+    {
+        ea[e] = _mm_set1_ps(tri.EdgeA[e]);
+        tl[e] = _mm_castsi128_ps(_mm_set1_epi32(tri.TopLeft[e] ? -1 : 0));
+    }
+    const __m128i lane_i = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i x0v = _mm_set1_epi32(x0 - 1), x1v = _mm_set1_epi32(x1);
+    const __m128 premul = _mm_loadu_ps(tri.Premul), inv_alpha = _mm_set1_ps(tri.InvAlpha);
+    const __m128i opaque = _mm_set1_epi32((int)tri.OpaqueColor);
+    for (int y = y0; y < y1; y++)
+    {
+        const float ly = (float)(y - tile_y0) + 0.5f;
+        __m128 row[3];
+        for (int e = 0; e < 3; e++)
+            row[e] = _mm_set1_ps(tri.EdgeB[e] * ly + edge_c[e]);
+        ImU32* dst_row = g_Target + (size_t)y * g_TargetStride;
+        for (int x = xs; x < x1; x += 4)
+        {
+            const __m128 lx = _mm_add_ps(_mm_set1_ps((float)(x - tile_x0)), lane);
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int e = 0; e < 3; e++)
+            {
+                const __m128 w = _mm_add_ps(_mm_mul_ps(ea[e], lx), row[e]);
+                inside = _mm_and_ps(inside, _mm_or_ps(_mm_cmpgt_ps(w, zero), _mm_and_ps(_mm_cmpeq_ps(w, zero), tl[e])));
+            }
+            // Lanes outside the clipped bounds (row start alignment, right edge)
+            const __m128i xi = _mm_add_epi32(_mm_set1_epi32(x), lane_i);
+            inside = _mm_and_ps(inside, _mm_castsi128_ps(_mm_and_si128(_mm_cmpgt_epi32(xi, x0v), _mm_cmplt_epi32(xi, x1v))));
+            int mask = _mm_movemask_ps(inside);
+            if (mask == 0xF && tri.Flat)
+            {
+                if (tri.Opaque)
+                    _mm_storeu_si128((__m128i*)(dst_row + x), opaque);
+                else
+                    ImGui_ImplSoft_Blend4(dst_row + x, premul, inv_alpha);
+                continue;
+            }
+            while (mask)
+            {
+                const int l = mask & 1 ? 0 : (mask & 2 ? 1 : (mask & 4 ? 2 : 3));
+                mask &= ~(1 << l);
+                ImGui_ImplSoft_ShadePixel(tri, dst_row + x + l, (float)(x + l) + 0.5f, (float)y + 0.5f);
+            }
+        }
+    }
+#else
+    for (int y = y0; y < y1; y++)
+    {
+        const float ly = (float)(y - tile_y0) + 0.5f;
+        float row[3];
+        for (int e = 0; e < 3; e++)
+            row[e] = tri.EdgeB[e] * ly + edge_c[e];
+        ImU32* dst_row = g_Target + (size_t)y * g_TargetStride;
+        for (int x = x0; x < x1; x++)
+        {
+            const float lx = (float)(x - tile_x0) + 0.5f;
+            bool inside = true;
+            for (int e = 0; e < 3 && inside; e++)
+            {
+                const float w = tri.EdgeA[e] * lx + row[e];
+                inside = w > 0.0f || (w == 0.0f && tri.TopLeft[e]);
+            }
+            if (inside)
+                ImGui_ImplSoft_ShadePixel(tri, dst_row + x, (float)x + 0.5f, (float)y + 0.5f);
+        }
+    }
+#endif
+}
+
+static void ImGui_ImplSoft_RenderTiles()
+{
+    const int tile_count = g_TilesX * g_TilesY;
+    for (int tile = g_NextTile.fetch_add(1); tile < tile_count; tile = g_NextTile.fetch_add(1))
+    {
+        const ImVector<int>& bin = g_Bins[tile];
+        const int tile_x0 = (tile % g_TilesX) * TILE_SIZE, tile_y0 = (tile / g_TilesX) * TILE_SIZE;
+        for (int n = 0; n < bin.Size; n++)
+            ImGui_ImplSoft_RasterizeInTile(g_Triangles[bin[n]], tile_x0, tile_y0);
+    }
+}
+
+static void ImGui_ImplSoft_SetupTriangle(const ImDrawVert& v0, const ImDrawVert& v1, const ImDrawVert& v2, const ImVec2& offset, const ImVec2& scale, const int clip[4], const ImGui_ImplSoft_Texture* tex)
+{
+    const ImDrawVert* verts[3] = { &v0, &v1, &v2 };
+    ImVec2 pos[3];
+    for (int n = 0; n < 3; n++)
+        pos[n] = ImVec2((verts[n]->pos.x - offset.x) * scale.x, (verts[n]->pos.y - offset.y) * scale.y);
+    const float e1x = pos[1].x - pos[0].x, e1y = pos[1].y - pos[0].y;
+    const float e2x = pos[2].x - pos[0].x, e2y = pos[2].y - pos[0].y;
+    const float area = e1x * e2y - e2x * e1y;
+    if (area == 0.0f || area != area)
+        return;
+
+    // Pixel centers inside [min, max): bounds rounded outwards, then clipped
+    int min_x = (int)floorf(std::min(pos[0].x, std::min(pos[1].x, pos[2].x)) - 0.5f), max_x = (int)ceilf(std::max(pos[0].x, std::max(pos[1].x, pos[2].x)) - 0.5f) + 1;
+    int min_y = (int)floorf(std::min(pos[0].y, std::min(pos[1].y, pos[2].y)) - 0.5f), max_y = (int)ceilf(std::max(pos[0].y, std::max(pos[1].y, pos[2].y)) - 0.5f) + 1;
+    min_x = std::max(min_x, clip[0]); min_y = std::max(min_y, clip[1]);
+    max_x = std::min(max_x, clip[2]); max_y = std::min(max_y, clip[3]);
+    if (min_x >= max_x || min_y >= max_y)
+        return;
+
+    g_Triangles.resize(g_Triangles.Size + 1);
+    ImGui_ImplSoft_Triangle& tri = g_Triangles.back();
+    tri.MinX = min_x; tri.MinY = min_y; tri.MaxX = max_x; tri.MaxY = max_y;
+    tri.Texture = tex;
+    const float sign = area > 0.0f ? 1.0f : -1.0f;
+    tri.Sign = sign;
+    for (int e = 0; e < 3; e++)
+    {
+        tri.Pos[e] = pos[e];
+        const ImVec2& a = pos[(e + 1) % 3];
+        const ImVec2& b = pos[(e + 2) % 3];
+        tri.EdgeA[e] = (a.y - b.y) * sign;
+        tri.EdgeB[e] = (b.x - a.x) * sign;
+        tri.TopLeft[e] = tri.EdgeA[e] > 0.0f || (tri.EdgeA[e] == 0.0f && tri.EdgeB[e] > 0.0f);
+    }
+
+    float attr[3][6];
+    for (int n = 0; n < 3; n++)
+    {
+        const ImU32 col = verts[n]->col;
+        for (int c = 0; c < 4; c++)
+            attr[n][c] = (float)((col >> (c * 8)) & 0xFF);
+        attr[n][4] = verts[n]->uv.x;
+        attr[n][5] = verts[n]->uv.y;
+    }
+    const float inv_area = 1.0f / area;
+    for (int k = 0; k < 6; k++)
+    {
+        const float d1 = attr[1][k] - attr[0][k], d2 = attr[2][k] - attr[0][k];
+        tri.Attr[k] = attr[0][k];
+        tri.AttrDx[k] = (d1 * e2y - d2 * e1y) * inv_area;
+        tri.AttrDy[k] = (d2 * e1x - d1 * e2x) * inv_area;
+    }
+    tri.ConstantColor = v0.col == v1.col && v0.col == v2.col;
+    tri.ConstantUv = v0.uv.x == v1.uv.x && v0.uv.x == v2.uv.x && v0.uv.y == v1.uv.y && v0.uv.y == v2.uv.y;
+    tri.Texel = tri.ConstantUv ? ImGui_ImplSoft_Sample(tex, v0.uv.x, v0.uv.y) : 0;
+    tri.Flat = tri.ConstantColor && tri.ConstantUv;
+    tri.Opaque = false;
+    tri.OpaqueColor = 0;
+    tri.Premul[0] = tri.Premul[1] = tri.Premul[2] = tri.Premul[3] = 0.0f;
+    tri.InvAlpha = 1.0f;
+    if (tri.Flat)
+    {
+        if (!ImGui_ImplSoft_Source(attr[0], tri.Texel, tri.Premul, &tri.InvAlpha))
+        {
+            g_Triangles.pop_back();
+            return;
+        }
+        tri.Opaque = tri.InvAlpha == 0.0f;
+        ImGui_ImplSoft_Blend(&tri.OpaqueColor, tri.Premul, tri.InvAlpha);
+    }
+}
+
+// Render function.
+void    ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, ImU32* pixels, int width, int height)
+{
+    const int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    const int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0 || pixels == NULL || width <= 0 || height <= 0)
+        return;
+
+    // Set up and bin every triangle, in submission order
+    g_Target = pixels;
+    g_TargetStride = width;
+    g_TargetWidth = std::min(width, fb_width);
+    g_TargetHeight = std::min(height, fb_height);
+    g_TilesX = (g_TargetWidth + TILE_SIZE - 1) / TILE_SIZE;
+    g_TilesY = (g_TargetHeight + TILE_SIZE - 1) / TILE_SIZE;
+    if ((int)g_Bins.size() < g_TilesX * g_TilesY)
+        g_Bins.resize(g_TilesX * g_TilesY);
+    for (int n = 0; n < g_TilesX * g_TilesY; n++)
+        g_Bins[n].resize(0);
+    g_Triangles.resize(0);
+
+    const ImVec2 clip_off = draw_data->DisplayPos;
+    const ImVec2 clip_scale = draw_data->FramebufferScale;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                // ImDrawCallback_ResetRenderState has nothing to reset here
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+            const ImGui_ImplSoft_Texture* tex = (const ImGui_ImplSoft_Texture*)pcmd->TextureId;
+            if (tex == NULL || tex->Pixels == NULL || tex->Width <= 0 || tex->Height <= 0)
+                continue;
+
+            // Project scissor/clipping rectangles into framebuffer space, the same integer rectangle glScissor() gets
+            ImVec4 clip_rect;
+            clip_rect.x = (pcmd->ClipRect.x - clip_off.x) * clip_scale.x;
+            clip_rect.y = (pcmd->ClipRect.y - clip_off.y) * clip_scale.y;
+            clip_rect.z = (pcmd->ClipRect.z - clip_off.x) * clip_scale.x;
+            clip_rect.w = (pcmd->ClipRect.w - clip_off.y) * clip_scale.y;
+            if (!(clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f))
+                continue;
+            int clip[4];
+            clip[0] = (int)clip_rect.x;
+            clip[1] = (int)clip_rect.y;
+            clip[2] = clip[0] + (int)(clip_rect.z - clip_rect.x);
+            clip[3] = clip[1] + (int)(clip_rect.w - clip_rect.y);
+            clip[0] = std::max(clip[0], 0); clip[1] = std::max(clip[1], 0);
+            clip[2] = std::min(clip[2], g_TargetWidth); clip[3] = std::min(clip[3], g_TargetHeight);
+            if (clip[0] >= clip[2] || clip[1] >= clip[3])
+                continue;
+
+            const ImDrawVert* vtx = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            for (unsigned int i = 0; i + 2 < pcmd->ElemCount; i += 3)
+            {
+                const int first = g_Triangles.Size;
+                ImGui_ImplSoft_SetupTriangle(vtx[idx[i]], vtx[idx[i + 1]], vtx[idx[i + 2]], clip_off, clip_scale, clip, tex);
+                if (first == g_Triangles.Size)
+                    continue;
+                const ImGui_ImplSoft_Triangle& tri = g_Triangles[first];
+                for (int ty = tri.MinY / TILE_SIZE; ty <= (tri.MaxY - 1) / TILE_SIZE; ty++)
+                    for (int tx = tri.MinX / TILE_SIZE; tx <= (tri.MaxX - 1) / TILE_SIZE; tx++)
+                        g_Bins[ty * g_TilesX + tx].push_back(first);
+            }
+        }
+    }
+
+    // Rasterize: workers and this thread share the tiles
+    g_NextTile.store(0);
+    {
+        std::lock_guard<std::mutex> lock(g_WorkersMutex);
+        g_WorkersGeneration++;
+        g_WorkersRunning = (int)g_Workers.size();
+    }
+    g_WorkersWake.notify_all();
+    ImGui_ImplSoft_RenderTiles();
+    std::unique_lock<std::mutex> lock(g_WorkersMutex);
+    g_WorkersDone.wait(lock, []() { return g_WorkersRunning == 0; });
+}
+
+bool    ImGui_ImplSoft_SavePPM(const char* filename, const ImU32* pixels, int width, int height)
+{
+    FILE* f = fopen(filename, "wb");
+    if (f == NULL)
+        return false;
+    fprintf(f, "P6\n%d %d\n255\n", width, height);
+    ImVector<unsigned char> row;
+    row.resize(width * 3);
+    bool ok = true;
+    for (int y = 0; y < height && ok; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            const ImU32 p = pixels[(size_t)y * width + x];
+            row[x * 3 + 0] = (unsigned char)(p >> IM_COL32_R_SHIFT);
+            row[x * 3 + 1] = (unsigned char)(p >> IM_COL32_G_SHIFT);
+            row[x * 3 + 2] = (unsigned char)(p >> IM_COL32_B_SHIFT);
+        }
+        ok = fwrite(row.Data, 1, (size_t)row.Size, f) == (size_t)row.Size;
+    }
+    return (fclose(f) == 0) && ok;
+}
@@ -0,0 +1,37 @@
+// dear imgui: Renderer for the CPU, rasterizing into an in-memory RGBA buffer
+// - No GPU or graphics API: for screenshot tests and benchmarks on headless machines.
+// This needs to be used along with a Platform Binding, or with inputs fed by hand (e.g. a headless test driver).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoft_Texture*' as ImTextureID.
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Scissor clipping, alpha blending (SRC_ALPHA, ONE_MINUS_SRC_ALPHA), textures sampled nearest and clamped.
+//  [X] Renderer: Tiled edge function rasterization, 4 pixels at a time with SSE2 (scalar fallback), tiles spread over worker threads.
+
+// The target is 'width' x 'height' ImU32 pixels in IM_COL32 layout (bytes R, G, B, A in memory on little endian machines),
+// rows 'width' pixels apart, top row first. RenderDrawData() blends over what is already there, clear it first if needed.
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+
+// Texture as seen by the rasterizer, IM_COL32 layout. Pass a pointer to one as ImTextureID.
+struct ImGui_ImplSoft_Texture
+{
+    int             Width;
+    int             Height;
+    const ImU32*    Pixels;
+};
+
+// Backend API
+// - 'threads': workers rasterizing tiles next to the calling thread. -1 picks one per hardware thread minus one, 0 renders on the caller only.
+IMGUI_IMPL_API bool     ImGui_ImplSoft_Init(int threads = -1);
+IMGUI_IMPL_API void     ImGui_ImplSoft_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoft_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, ImU32* pixels, int width, int height);
+
+// Called by Init/NewFrame/Shutdown
+IMGUI_IMPL_API bool     ImGui_ImplSoft_CreateFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoft_DestroyFontsTexture();
+
+// (Optional) Binary PPM (P6) of a buffer filled by RenderDrawData, alpha dropped. Returns false if the file can't be written.
+IMGUI_IMPL_API bool     ImGui_ImplSoft_SavePPM(const char* filename, const ImU32* pixels, int width, int height);
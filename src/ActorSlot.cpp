@@ -0,0 +1,229 @@
+#include "ActorSlot.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+#include "DiceReservoir.hpp"
+
+
+const std::array<std::string, static_cast<size_t>(ActorStat::END_OF_LIST)> statsNames{
+	"Str",
+	"Dex",
+	"Mind",
+	"Agi",
+	"Infl",
+	"End"};
+
+const std::string& g_stat_name(const ActorStat& stat_) { return statsNames.at(static_cast<size_t>(stat_));}
+
+
+ActorAction& operator++(ActorAction &c) {
+	if (c == ActorAction::END_OF_LIST) c = static_cast<ActorAction>(0);
+	else {
+		using IntType = typename std::underlying_type<ActorAction>::type;
+		c = static_cast<ActorAction>(static_cast<IntType>(c) + 1);
+	}
+	return c;
+}
+
+ActorAction operator++(ActorAction &c, int) {
+	ActorAction result = c;
+	++c;
+	return result;
+}
+
+
+std::array<ActionsData, static_cast<size_t>(ActorAction::END_OF_LIST)+1> ActionsData::allData;
+
+void ActionsData::init(){
+	allData.at(static_cast<size_t>(ActorAction::None)) = 			{"---", {ActorStat::END_OF_LIST, ActorStat::END_OF_LIST}};
+	allData.at(static_cast<size_t>(ActorAction::Move)) = 			{"Move", {ActorStat::END_OF_LIST, ActorStat::END_OF_LIST}};
+	allData.at(static_cast<size_t>(ActorAction::Move_Contest)) = 	{"Move Contest", {ActorStat::Agi, ActorStat::Agi}};
+	allData.at(static_cast<size_t>(ActorAction::Attack)) = 			{"Attack", {ActorStat::Str, ActorStat::Dex}};
+	allData.at(static_cast<size_t>(ActorAction::Shoot)) = 			{"Shoot", {ActorStat::Dex, ActorStat::Mind}};
+	allData.at(static_cast<size_t>(ActorAction::Concentration)) = 	{"Concentration", {ActorStat::Mind, ActorStat::Mind}};
+	allData.at(static_cast<size_t>(ActorAction::Graple)) = 			{"Graple", {ActorStat::Str, ActorStat::Dex}};
+	allData.at(static_cast<size_t>(ActorAction::Sweep)) = 			{"Sweep", {ActorStat::Str, ActorStat::Dex}};
+	allData.at(static_cast<size_t>(ActorAction::Dodge)) = 			{"Dodge", {ActorStat::Dex, ActorStat::Agi}};
+	allData.at(static_cast<size_t>(ActorAction::Block)) = 			{"Block", {ActorStat::Str, ActorStat::Dex}};
+	allData.at(static_cast<size_t>(ActorAction::Shelter)) = 		{"Shelter", {ActorStat::Agi, ActorStat::Agi}};
+	allData.at(static_cast<size_t>(ActorAction::Item)) = 			{"Item", {ActorStat::END_OF_LIST, ActorStat::END_OF_LIST}};
+	allData.at(static_cast<size_t>(ActorAction::Item_Contest)) = 	{"Item Contest", {ActorStat::Dex, ActorStat::Agi}};
+	allData.at(static_cast<size_t>(ActorAction::Remove_Effect)) = 	{"Remove Effect", {ActorStat::Dex, ActorStat::Dex}};
+	allData.at(static_cast<size_t>(ActorAction::Help)) = 			{"Help", {ActorStat::END_OF_LIST, ActorStat::END_OF_LIST}};
+	allData.at(static_cast<size_t>(ActorAction::Special)) = 		{"Special", {ActorStat::END_OF_LIST, ActorStat::END_OF_LIST}};
+	allData.at(static_cast<size_t>(ActorAction::END_OF_LIST)) = 	{"---", {ActorStat::END_OF_LIST, ActorStat::END_OF_LIST}};
+}
+
+
+
+static const int maxMobBonusDice = 10;
+
+
+const std::array<uint8_t, static_cast<size_t>(ActorBodyPart::END_OF_LIST)> ActorTemplate::defaultHitBoxes{
+	4,	// Head
+	10,	// Body
+	5,	// Left_Hand
+	5,	// Right_Hand
+	5,	// Left_Leg
+	5};	// Right_Leg
+
+size_t ActorTemplate::g_hit_box_offset(const ActorBodyPart& part_) const {
+	size_t tempOffset = 0;
+	for (size_t i = 0; i < static_cast<size_t>(part_); i++) tempOffset += this->hitBoxes.at(i);
+	return tempOffset;
+}
+
+
+uint64_t ActorSlot::lastLabelVersion{0};
+
+ActorSlot::ActorSlot(const std::shared_ptr<ActorTemplate>& proto_, const bool& player_, const uint32_t& number_)
+	: proto{ proto_ }, number{ number_ }, addInitiative{ proto_->addInitiative }, player{ player_ }{
+	if (this->proto->g_total_hit_boxes() > maxHitBoxes) throw std::length_error("ActorSlot: too many hit boxes");
+	this->refresh_label();
+	this->set_number_of_actions();
+	this->calc_initiative();
+}
+
+void ActorSlot::set_hit_point(const ActorBodyPart& part_, const size_t& box_, const char& value_){
+	if (box_ >= this->g_hit_boxes(part_)) return;
+	this->wounds.at(this->proto->g_hit_box_offset(part_) + box_) = value_;
+}
+
+ActorTemplate& ActorSlot::edit_template(){
+	if (this->proto.use_count() > 1) this->proto = ActorTemplate::create(*this->proto);
+	return *this->proto;
+}
+
+// Numbered labels are per instance, so they live in the slot rather than in the string pool.
+void ActorSlot::refresh_label(){
+	this->labelVersion = ++ActorSlot::lastLabelVersion;
+	if (this->number == 0 && !this->is_mob()) { this->label[0] = '\0'; return; }
+	std::snprintf(this->label.data(), this->label.size(), this->is_mob() ? "%s mob %u" : "%s %u", this->g_name(), this->number);
+}
+
+void ActorSlot::set_action(const size_t& index_, const ActorAction& action_){
+	this->set_action_roll(index_, 100);
+	auto& tempAction = this->actions.at(index_);
+	std::get<0>(tempAction) = action_;
+	std::get<1>(tempAction) = nullptr;
+	this->calculate_number_of_dices();
+}
+
+void ActorSlot::set_action_roll(const size_t& index_, const size_t& roll_){
+	auto& tempAction = this->actions.at(index_);
+	if (std::get<2>(tempAction) < maxRolls) this->claimedRolls &= static_cast<uint16_t>(~(1u << std::get<2>(tempAction)));
+	std::get<2>(tempAction) = roll_ < this->rolls.size() ? roll_ : 100;
+	if (std::get<2>(tempAction) < maxRolls) this->claimedRolls |= static_cast<uint16_t>(1u << std::get<2>(tempAction));
+}
+
+void ActorSlot::set_number_of_actions(){
+	const int requestedActions = std::min(this->g_stats(ActorStat::Dex), static_cast<int>(maxActions));
+	if (requestedActions < 0) return;
+	this->actions.reserve(static_cast<size_t>(requestedActions));
+	while (this->actions.size() != static_cast<size_t>(requestedActions)){
+		if (this->actions.size() < static_cast<size_t>(requestedActions)) this->actions.emplace_back(ActorAction::END_OF_LIST, nullptr, 100);
+		else { this->set_action_roll(this->actions.size() - 1, 100); this->actions.pop_back(); }
+	}
+}
+
+void ActorSlot::calculate_number_of_dices(){
+	this->numberOfDice = 100;
+	for (const auto& Fi : this->actions){
+		if (std::get<0>(Fi) >= ActorAction::END_OF_LIST) continue;
+		if (ActionsData::g_data(std::get<0>(Fi)).g_dice_stats().first >= ActorStat::END_OF_LIST || ActionsData::g_data(std::get<0>(Fi)).g_dice_stats().second >= ActorStat::END_OF_LIST) continue;
+		int tempDices = this->g_stats(ActionsData::g_data(std::get<0>(Fi)).g_dice_stats().first) + this->g_stats(ActionsData::g_data(std::get<0>(Fi)).g_dice_stats().second);
+		if (tempDices < this->numberOfDice) this->numberOfDice = tempDices;
+	}
+	if (this->numberOfDice == 100) this->numberOfDice = 0;
+}
+
+int ActorSlot::g_pool_size() const {
+	if (this->is_mob() && this->g_mob_alive() == 0) return 0;
+	return this->numberOfDice + this->addRoll + this->g_mob_bonus_dice();
+}
+
+int ActorSlot::g_mob_bonus_dice() const {
+	if (!this->is_mob() || this->g_mob_alive() < 2) return 0;
+	return std::min<int>(static_cast<int>(this->g_mob_alive()) - 1, maxMobBonusDice);
+}
+
+uint32_t ActorSlot::g_mob_acting() const {
+	uint32_t tempSets = 0;
+	for (const auto& Ri : this->rolls) { if (Ri.second >= 2) tempSets++; }
+	return std::min(tempSets, this->g_mob_alive());
+}
+
+uint32_t ActorSlot::g_mob_alive() const {
+	const uint32_t tempDown = this->mobWounds / this->g_mob_toughness();
+	return tempDown >= this->mobSize ? 0 : this->mobSize - tempDown;
+}
+
+void ActorSlot::add_mob_wounds(const int& amount_){
+	const int tempWounds = static_cast<int>(this->mobWounds) + amount_;
+	this->mobWounds = static_cast<uint32_t>(std::max(0, std::min(tempWounds, static_cast<int>(this->mobSize * this->g_mob_toughness()))));
+}
+
+void ActorSlot::add_face(const int& face_){
+	for (auto& Fi : this->rolls) { if (face_ == Fi.first) { Fi.second++; return; }}
+	this->rolls.emplace_back(std::make_pair(face_, 1));
+}
+
+void ActorSlot::finish_roll(){
+	this->rolled = true;
+	for (auto& Fi : this->actions) { std::get<2>(Fi) = 100; }
+	this->claimedRolls = 0;
+}
+
+void ActorSlot::roll(){
+	this->rolls.clear();
+	std::array<int, 64> tempFaces;
+	for (size_t tempLeft = static_cast<size_t>(std::max(0, this->g_pool_size())); tempLeft > 0;){
+		const size_t tempCount = std::min(tempLeft, tempFaces.size());
+		DiceReservoir::draw(tempFaces.data(), tempCount);
+		for (size_t i = 0; i < tempCount; i++) this->add_face(tempFaces[i]);
+		tempLeft -= tempCount;
+	}
+	this->finish_roll();
+}
+
+void ActorSlot::roll(const int* faces_, const size_t& count_){
+	this->rolls.clear();
+	for (size_t i = 0; i < count_; i++) { if (faces_[i] >= 1 && faces_[i] <= 10) this->add_face(faces_[i]); }
+	this->finish_roll();
+}
+
+void ActorSlot::new_turn(){
+	this->addRoll = 0;
+	this->numberOfDice = 0;
+	this->rolled=false;
+	this->actions.clear();
+	this->rolls.clear();
+	this->claimedRolls = 0;
+	this->set_number_of_actions();
+}
+
+void ActorSlot::add_hp(const int& direction_, const int& amount_, const bool& heal_){
+	int tempDir{-1};
+	switch(direction_){
+		case 1:	break;
+		case 2:	break;
+		case 3:	break;
+		case 4:	break;
+		case 5:	break;
+		case 6:	break;
+		case 7:	break;
+		case 8:	break;
+		case 9:	break;
+		case 10:break;
+		default:
+			break;
+
+	}
+	if (tempDir < 0 || tempDir >= static_cast<int>(ActorBodyPart::END_OF_LIST)) return;
+	for (size_t i = 0; i < this->g_hit_boxes(static_cast<ActorBodyPart>(tempDir)); i++) {
+		
+
+	}
+}
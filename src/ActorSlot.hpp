@@ -0,0 +1,226 @@
+#ifndef _ACTOR_SLOT_HPP_
+#define _ACTOR_SLOT_HPP_
+
+#include <cstdint>
+#include <string>
+#include <array>
+#include <vector>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <list>
+
+#include "StringPool.hpp"
+#include "ObjectPool.hpp"
+
+
+enum class ActorStat {
+	Str,
+	Dex,
+	Mind,
+	Agi,
+	Infl,
+	End,
+	END_OF_LIST
+
+};
+enum class ActorBodyPart {
+	Head,
+	Body,
+	Left_Hand,
+	Right_Hand,
+	Left_Leg,
+	Right_Leg,
+	END_OF_LIST
+
+};
+
+extern const std::array<std::string, static_cast<size_t>(ActorStat::END_OF_LIST)> statsNames;
+
+const std::string& g_stat_name(const ActorStat& stat_);
+
+
+enum class ActorAction{
+	None,
+	Move,
+	Move_Contest,
+	Attack,
+	Shoot,
+	Concentration,
+	Graple,
+	Sweep,
+	Dodge,
+	Block,
+	Shelter,
+	Item,
+	Item_Contest,
+	Remove_Effect,
+	Help,
+	Special,
+	END_OF_LIST
+};
+
+ActorAction& operator++(ActorAction &c);
+ActorAction operator++(ActorAction &c, int);
+
+class ActionsData{
+private:
+	std::string name{""};
+	std::pair<ActorStat, ActorStat> diceStats{ActorStat::END_OF_LIST, ActorStat::END_OF_LIST};
+	
+	static std::array<ActionsData, static_cast<size_t>(ActorAction::END_OF_LIST)+1> allData;
+
+public:
+	ActionsData() = default;
+	ActionsData(const std::string& name_, const std::pair<ActorStat, ActorStat>& diceStats_) : name{name_}, diceStats{diceStats_} {} 
+	
+
+	const std::string& g_name() const {return this->name; }
+	const std::pair<ActorStat, ActorStat>& g_dice_stats() const { return this->diceStats; }
+
+	static const ActionsData& g_data(const ActorAction& action_) { return ActionsData::allData.at(static_cast<size_t>(action_)); }
+	static void init();
+
+};
+
+
+// Immutable data shared by every instance spawned from the same stat block.
+struct ActorTemplate {
+	static const std::array<uint8_t, static_cast<size_t>(ActorBodyPart::END_OF_LIST)> defaultHitBoxes;
+
+	NameId name;
+	std::array<int, 6> stats;
+	std::array<uint8_t, static_cast<size_t>(ActorBodyPart::END_OF_LIST)> hitBoxes;
+	int addInitiative{0};
+	uint32_t lastNumber{0};					// numbering of spawned instances
+
+	ActorTemplate(const NameId& name_, const std::array<int, 6>& stats_, const int& addInitiative_)
+		: name{ name_ }, stats{ stats_ }, hitBoxes{ defaultHitBoxes }, addInitiative{ addInitiative_ } {}
+	ActorTemplate(const std::string& name_, const std::array<int, 6>& stats_, const int& addInitiative_)
+		: ActorTemplate(StringPool::global().intern(name_), stats_, addInitiative_) {}
+
+	template<class... Args>
+	static std::shared_ptr<ActorTemplate> create(Args&&... args_) { return std::allocate_shared<ActorTemplate>(PoolAllocator<ActorTemplate>(), std::forward<Args>(args_)...); }
+
+	size_t g_hit_box_offset(const ActorBodyPart& part_) const;
+	size_t g_total_hit_boxes() const { return this->g_hit_box_offset(ActorBodyPart::END_OF_LIST); }
+};
+
+
+// One actor in the roster. Name, stats and body layout come from a shared template,
+// the slot itself only keeps what changes during play. Changing template data through
+// edit_template() copies the template first, so other instances are unaffected.
+// A mob is a slot standing for mobSize identical creatures: wounds go to one shared
+// pool (a member drops every g_mob_toughness() wounds) and the whole mob makes a
+// single roll, one extra die per living member beyond the first. The roll is dealt out to
+// the members: each set in it goes to one living member, the members left over don't act.
+// A mob with nobody alive rolls no dice and can't be targeted.
+class ActorSlot : public std::enable_shared_from_this<ActorSlot>{
+	friend class std::shared_ptr<ActorSlot>;
+public:
+	using ActionEntry = std::tuple<ActorAction, std::shared_ptr<ActorSlot>, size_t>;
+	static const size_t maxActions = 8;
+	static const size_t maxRolls = 10;		// one entry per die face
+	static const size_t maxHitBoxes = 48;
+	static const size_t maxLabel = 64;
+
+private:
+	std::shared_ptr<ActorTemplate> proto;
+	InlineVector<ActionEntry, maxActions> actions;
+	InlineVector<std::pair<int, int>, maxRolls> rolls; 	// number, amount
+	std::array<char, maxHitBoxes> wounds{};
+	uint16_t claimedRolls{0};				// bit per roll entry already taken by an action
+	std::array<char, maxLabel> label{};		// "Name N" / "Name mob N", unused for a lone actor
+	uint64_t labelVersion{0};				// changes with the label, unique across slots
+	uint32_t number{0};						// position inside a spawned group, 0 when alone
+	uint32_t mobSize{0};					// creatures represented by this slot, 0 for a single actor
+	uint32_t mobWounds{0};					// aggregate wound pool of the whole mob
+	int numberOfDice{0};
+	int addInitiative{0};
+	int initiative{0};
+	int addRoll{0};
+	bool player{false};
+	bool rolled{false};
+	bool initChanged{false};
+	bool showBody{false};
+
+	static uint64_t lastLabelVersion;
+
+	void add_face(const int& face_);
+	void finish_roll();
+
+public:
+
+	ActorSlot(const std::shared_ptr<ActorTemplate>& proto_, const bool& player_, const uint32_t& number_ = 0);
+	ActorSlot(const std::string& name_, const std::array<int, 6>& stats_, const bool& player_, const int& addInitiative_)
+		: ActorSlot(ActorTemplate::create(name_, stats_, addInitiative_), player_) {}
+
+	// Actor records, their shared_ptr control blocks and inline buffers come from one pool.
+	template<class... Args>
+	static std::shared_ptr<ActorSlot> create(Args&&... args_) { return std::allocate_shared<ActorSlot>(PoolAllocator<ActorSlot>(), std::forward<Args>(args_)...); }
+
+	const int& g_initiative() const { return this->initiative; } 
+	const char* g_name() const { return name_str(this->proto->name); }
+	const char* g_label() const { return this->number == 0 && !this->is_mob() ? this->g_name() : this->label.data(); }
+	const uint64_t& g_label_version() const { return this->labelVersion; }
+	const uint32_t& g_number() const { return this->number; }
+	const std::shared_ptr<ActorTemplate>& g_template() const { return this->proto; }
+	const std::array<int, 6>& g_stats() const { return this->proto->stats; }
+	const int& g_stats(const ActorStat& stat_) const { return this->proto->stats.at(static_cast<size_t>(stat_)); }
+	const int& g_number_of_dice() const { return this->numberOfDice; }
+	int g_pool_size() const;
+	int g_mob_bonus_dice() const;
+	// Living members the last roll gave a set to.
+	uint32_t g_mob_acting() const;
+	bool is_mob() const { return this->mobSize > 0; }
+	const uint32_t& g_mob_size() const { return this->mobSize; }
+	const uint32_t& g_mob_wounds() const { return this->mobWounds; }
+	uint32_t g_mob_alive() const;
+	uint32_t g_mob_toughness() const { return std::max<uint32_t>(1, static_cast<uint32_t>(this->g_hit_boxes(ActorBodyPart::Body))); }
+	int& g_add_roll() { return this->addRoll; }
+	const bool& is_player() const { return this->player; }
+	const bool& g_rolled() const { return this->rolled; }
+	const bool& g_show_body() const { return this->showBody; }
+	InlineVector<ActionEntry, maxActions>& g_actions() { return this->actions; }
+	InlineVector<std::pair<int, int>, maxRolls>& g_rolls() { return this->rolls; }
+	bool is_roll_claimed(const size_t& roll_) const { return roll_ < maxRolls && (this->claimedRolls & (1u << roll_)) != 0; }
+
+	void set_action(const size_t& index_, const ActorAction& action_);
+	void set_action_roll(const size_t& index_, const size_t& roll_);
+
+	size_t g_hit_boxes(const ActorBodyPart& part_) const { return this->proto->hitBoxes.at(static_cast<size_t>(part_)); }
+	char g_hit_point(const ActorBodyPart& part_, const size_t& box_) const { return box_ < this->g_hit_boxes(part_) ? this->wounds[this->proto->g_hit_box_offset(part_) + box_] : 0; }
+	void set_hit_point(const ActorBodyPart& part_, const size_t& box_, const char& value_);
+	
+	void set_show_body(const bool& var_) { this->showBody = var_; }
+	void set_mob_size(const uint32_t& size_) { this->mobSize = size_; this->mobWounds = std::min(this->mobWounds, size_ * this->g_mob_toughness()); this->refresh_label(); }
+	void add_mob_wounds(const int& amount_);
+
+	ActorTemplate& edit_template();
+	void template_changed() { this->refresh_label(); this->set_number_of_actions(); this->calc_initiative(); this->calculate_number_of_dices(); }
+
+	void change_additional_initiative(const int& value_) { this->addInitiative = value_; this->calc_initiative(); }
+
+	void calc_initiative() { 
+		int tempInit = this->initiative;
+		this->initiative = (this->g_stats(ActorStat::Mind)*2) + this->addInitiative; 
+		if (tempInit != 0 && tempInit != this->initiative) this->initChanged = true;
+	}
+	
+	void refresh_label();
+	void set_number_of_actions();
+	void calculate_number_of_dices();
+	void roll();
+	// Takes the faces (1 to 10) instead of rolling them, for scenarios and replays.
+	void roll(const int* faces_, const size_t& count_);
+	void new_turn();
+	void add_hp(const int& direction_, const int& amount_, const bool& heal_);
+
+};
+
+using ActorList = std::list<std::shared_ptr<ActorSlot>, PoolAllocator<std::shared_ptr<ActorSlot>>>;
+
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include "Bestiary.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+static const char bestiaryMagic[4] = {'M', 'H', 'B', 'S'};
+static const uint32_t bestiaryVersion = 1;
+
+
+bool MappedFile::open(const std::string& path_){
+	this->close();
+#ifdef _WIN32
+	HANDLE tempFile = CreateFileA(path_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (tempFile == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER tempSize;
+	if (!GetFileSizeEx(tempFile, &tempSize) || tempSize.QuadPart == 0) { CloseHandle(tempFile); return false; }
+	HANDLE tempMapping = CreateFileMappingA(tempFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (tempMapping == nullptr) { CloseHandle(tempFile); return false; }
+	const void* tempView = MapViewOfFile(tempMapping, FILE_MAP_READ, 0, 0, 0);
+	if (tempView == nullptr) { CloseHandle(tempMapping); CloseHandle(tempFile); return false; }
+	this->fileHandle = tempFile;
+	this->mappingHandle = tempMapping;
+	this->data = static_cast<const char*>(tempView);
+	this->size = static_cast<size_t>(tempSize.QuadPart);
+#else
+	const int tempFile = ::open(path_.c_str(), O_RDONLY);
+	if (tempFile < 0) return false;
+	struct stat tempStat;
+	if (fstat(tempFile, &tempStat) != 0 || tempStat.st_size == 0) { ::close(tempFile); return false; }
+	void* tempView = mmap(nullptr, static_cast<size_t>(tempStat.st_size), PROT_READ, MAP_PRIVATE, tempFile, 0);
+	::close(tempFile);
+	if (tempView == MAP_FAILED) return false;
+	this->data = static_cast<const char*>(tempView);
+	this->size = static_cast<size_t>(tempStat.st_size);
+#endif
+	return true;
+}
+
+void MappedFile::swap(MappedFile& other_){
+	std::swap(this->data, other_.data);
+	std::swap(this->size, other_.size);
+#ifdef _WIN32
+	std::swap(this->fileHandle, other_.fileHandle);
+	std::swap(this->mappingHandle, other_.mappingHandle);
+#endif
+}
+
+void MappedFile::close(){
+	if (this->data == nullptr) return;
+#ifdef _WIN32
+	UnmapViewOfFile(this->data);
+	CloseHandle(this->mappingHandle);
+	CloseHandle(this->fileHandle);
+	this->mappingHandle = nullptr;
+	this->fileHandle = nullptr;
+#else
+	munmap(const_cast<char*>(this->data), this->size);
+#endif
+	this->data = nullptr;
+	this->size = 0;
+}
+
+
+
+bool Bestiary::map_file(MappedFile& file_, uint32_t& count_) const {
+	count_ = 0;
+	if (!file_.open(this->path)) return false;
+
+	Header tempHeader;
+	if (file_.g_size() < sizeof(Header)) { file_.close(); return false; }
+	std::memcpy(&tempHeader, file_.g_data(), sizeof(Header));
+	const size_t tempNeeded = sizeof(Header) + static_cast<size_t>(tempHeader.count) * sizeof(Record) + tempHeader.namesSize;
+	if (std::memcmp(tempHeader.magic, bestiaryMagic, 4) != 0 || tempHeader.version != bestiaryVersion || tempNeeded > file_.g_size()){
+		std::cout << "BESTIARY: " << this->path << " is not a valid bestiary file\n";
+		file_.close();
+		return false;
+	}
+
+	// Names are handed out as C strings, so each one must end inside the names block.
+	const Record* tempRecords = reinterpret_cast<const Record*>(file_.g_data() + sizeof(Header));
+	const char* tempNames = file_.g_data() + sizeof(Header) + static_cast<size_t>(tempHeader.count) * sizeof(Record);
+	for (uint32_t i = 0; i < tempHeader.count; i++){
+		const uint64_t tempEnd = static_cast<uint64_t>(tempRecords[i].nameOffset) + tempRecords[i].nameLength;
+		if (tempEnd >= tempHeader.namesSize || tempNames[tempEnd] != '\0'){
+			std::cout << "BESTIARY: " << this->path << " is corrupted\n";
+			file_.close();
+			return false;
+		}
+	}
+	count_ = tempHeader.count;
+	return true;
+}
+
+void Bestiary::use_mapping(MappedFile& file_, const uint32_t& count_){
+	this->mapped.swap(file_);
+	file_.close();
+	this->mappedRecords = reinterpret_cast<const Record*>(this->mapped.g_data() + sizeof(Header));
+	this->mappedNames = this->mapped.g_data() + sizeof(Header) + static_cast<size_t>(count_) * sizeof(Record);
+	this->mappedCount = count_;
+}
+
+void Bestiary::drop_mapping(){
+	this->mappedRecords = nullptr;
+	this->mappedNames = nullptr;
+	this->mappedCount = 0;
+	this->mapped.close();
+}
+
+void Bestiary::reindex(){
+	this->index.clear();
+	for (size_t i = 0; i < this->size(); i++) this->index.add(this->g_name(i), this->g_record(i).nameLength);
+}
+
+bool Bestiary::open(const std::string& path_){
+	this->path = path_;
+	this->addedRecords.clear();
+	this->addedNames.clear();
+	this->index.clear();
+	this->drop_mapping();
+	MappedFile tempFile;
+	uint32_t tempCount;
+	if (!this->map_file(tempFile, tempCount)) return false;
+	this->use_mapping(tempFile, tempCount);
+	this->reindex();
+	return true;
+}
+
+bool Bestiary::save(){
+	if (this->path.empty()) return false;
+	if (!this->has_unsaved()) return true;
+
+	const std::string tempPath = this->path + ".tmp";
+	FILE* tempFile = std::fopen(tempPath.c_str(), "wb");
+	if (tempFile == nullptr) return false;
+
+	Header tempHeader;
+	std::memcpy(tempHeader.magic, bestiaryMagic, 4);
+	tempHeader.version = bestiaryVersion;
+	tempHeader.count = static_cast<uint32_t>(this->size());
+	tempHeader.namesSize = 0;
+	std::vector<Record> tempRecords;
+	tempRecords.reserve(this->size());
+	for (size_t i = 0; i < this->size(); i++){
+		Record tempRecord = this->g_record(i);
+		tempRecord.nameOffset = tempHeader.namesSize;
+		tempHeader.namesSize += tempRecord.nameLength + 1;
+		tempRecords.push_back(tempRecord);
+	}
+
+	bool tempOk = std::fwrite(&tempHeader, sizeof(Header), 1, tempFile) == 1;
+	if (tempOk && !tempRecords.empty()) tempOk = std::fwrite(tempRecords.data(), sizeof(Record), tempRecords.size(), tempFile) == tempRecords.size();
+	for (size_t i = 0; tempOk && i < tempRecords.size(); i++){
+		tempOk = std::fwrite(this->g_name(i), 1, tempRecords[i].nameLength + 1, tempFile) == tempRecords[i].nameLength + 1;
+	}
+	tempOk = (std::fclose(tempFile) == 0) && tempOk;
+	if (!tempOk) { std::remove(tempPath.c_str()); return false; }
+
+	// The old file is replaced in one step and stays mapped until the new one is, so a
+	// failure anywhere leaves both the file on disk and the view in memory as they were.
+	// Windows can't replace a mapped file: there the old one is unmapped first and mapped
+	// again if the move fails.
+#ifdef _WIN32
+	const uint32_t tempOldCount = this->mappedCount;
+	this->drop_mapping();
+	const bool tempMoved = MoveFileExA(tempPath.c_str(), this->path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	const bool tempMoved = std::rename(tempPath.c_str(), this->path.c_str()) == 0;
+#endif
+	MappedFile tempMapping;
+	uint32_t tempCount{0};
+	if (tempMoved && this->map_file(tempMapping, tempCount) && tempCount == this->size()){
+		this->use_mapping(tempMapping, tempCount);
+		// Ids are kept in the same order, so the index stays valid as is.
+		this->addedRecords.clear();
+		this->addedNames.clear();
+		return true;
+	}
+
+	std::cout << "BESTIARY: failed to replace " << this->path << "\n";
+	if (!tempMoved) std::remove(tempPath.c_str());
+#ifdef _WIN32
+	if (!tempMoved && this->map_file(tempMapping, tempCount) && tempCount == tempOldCount) this->use_mapping(tempMapping, tempCount);
+	else {
+		// Neither file maps back: only the unsaved entries are left, with new ids.
+		std::cout << "BESTIARY: " << tempOldCount << " saved entries unavailable until restart\n";
+		this->reindex();
+	}
+#endif
+	return false;
+}
+
+const char* Bestiary::g_name(const size_t& id_) const {
+	if (id_ < this->mappedCount) return this->mappedNames + this->mappedRecords[id_].nameOffset;
+	return this->addedNames.at(id_ - this->mappedCount).c_str();
+}
+
+const Bestiary::Record& Bestiary::g_record(const size_t& id_) const {
+	if (id_ < this->mappedCount) return this->mappedRecords[id_];
+	return this->addedRecords.at(id_ - this->mappedCount);
+}
+
+BestiaryEntry Bestiary::g_entry(const size_t& id_) const {
+	const Record& tempRecord = this->g_record(id_);
+	BestiaryEntry tempEntry;
+	tempEntry.name = this->g_name(id_);
+	tempEntry.nameLength = tempRecord.nameLength;
+	for (size_t i = 0; i < tempEntry.stats.size(); i++) tempEntry.stats[i] = tempRecord.stats[i];
+	tempEntry.addInitiative = tempRecord.addInitiative;
+	return tempEntry;
+}
+
+size_t Bestiary::add(const std::string& name_, const std::array<int, 6>& stats_, const int& addInitiative_){
+	Record tempRecord;
+	tempRecord.nameOffset = 0;
+	tempRecord.nameLength = static_cast<uint32_t>(name_.size());
+	for (size_t i = 0; i < stats_.size(); i++) tempRecord.stats[i] = stats_[i];
+	tempRecord.addInitiative = addInitiative_;
+	this->addedRecords.push_back(tempRecord);
+	this->addedNames.push_back(name_);
+	return this->index.add(name_.c_str(), name_.size());
+}
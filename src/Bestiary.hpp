@@ -0,0 +1,102 @@
+#ifndef _BESTIARY_HPP_
+#define _BESTIARY_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string>
+#include <vector>
+#include <deque>
+
+#include "TrigramIndex.hpp"
+
+
+// Read-only view of a whole file mapped into memory.
+class MappedFile {
+private:
+	const char* data{nullptr};
+	size_t size{0};
+#ifdef _WIN32
+	void* fileHandle{nullptr};
+	void* mappingHandle{nullptr};
+#endif
+
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile() { this->close(); }
+
+	const char* g_data() const { return this->data; }
+	const size_t& g_size() const { return this->size; }
+
+	bool open(const std::string& path_);
+	void close();
+	void swap(MappedFile& other_);
+};
+
+
+struct BestiaryEntry {
+	const char* name;
+	size_t nameLength;
+	std::array<int, 6> stats;
+	int addInitiative;
+};
+
+
+// Monster stat block library. Entries saved on disk are served straight from the mapped
+// file, entries added during the session live in memory until save(). Both are searchable
+// through the same incrementally built trigram index.
+class Bestiary {
+private:
+	struct Record {
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		int32_t stats[6];
+		int32_t addInitiative;
+	};
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t count;
+		uint32_t namesSize;
+	};
+
+	std::string path;
+	MappedFile mapped;
+	const Record* mappedRecords{nullptr};
+	const char* mappedNames{nullptr};
+	uint32_t mappedCount{0};
+
+	std::vector<Record> addedRecords;
+	std::deque<std::string> addedNames;
+
+	TrigramIndex index;
+
+	const char* g_name(const size_t& id_) const;
+	const Record& g_record(const size_t& id_) const;
+	// Maps and checks path into file_, the current view is left alone.
+	bool map_file(MappedFile& file_, uint32_t& count_) const;
+	void use_mapping(MappedFile& file_, const uint32_t& count_);
+	void drop_mapping();
+	void reindex();
+
+public:
+	Bestiary() = default;
+	Bestiary(const Bestiary&) = delete;
+	Bestiary& operator=(const Bestiary&) = delete;
+
+	size_t size() const { return this->mappedCount + this->addedRecords.size(); }
+	bool has_unsaved() const { return !this->addedRecords.empty(); }
+
+	bool open(const std::string& path_);
+	bool save();
+
+	BestiaryEntry g_entry(const size_t& id_) const;
+	size_t add(const std::string& name_, const std::array<int, 6>& stats_, const int& addInitiative_);
+	void search(const char* query_, const size_t& maxResults_, std::vector<uint32_t>& results_) const { this->index.search(query_, maxResults_, results_); }
+};
+
+
+
+#endif
@@ -0,0 +1,111 @@
+#include "CommandPalette.hpp"
+
+#include <cstring>
+
+
+TrigramIndex CommandPalette::index;
+std::vector<PaletteEntry> CommandPalette::entries;
+std::vector<uint64_t> CommandPalette::seenStamps;
+std::unordered_map<const ActorSlot*, uint32_t> CommandPalette::actorIds;
+uint64_t CommandPalette::syncedRevision{~0ull};
+uint64_t CommandPalette::syncStamp{0};
+bool CommandPalette::fixedIndexed{false};
+
+static const size_t rebuildMinimum = 1024;
+
+static const char* commandNames[] = {"Roll All", "Roll Enemies", "Roll Players", "Next Turn", "Show Body"};
+
+
+const char* CommandPalette::g_command_name(const PaletteCommand& command_){
+	return command_ < PaletteCommand::END_OF_LIST ? commandNames[static_cast<size_t>(command_)] : "";
+}
+
+uint32_t CommandPalette::add(PaletteEntry&& entry_){
+	const uint32_t tempId = CommandPalette::index.add(entry_.g_label(), std::strlen(entry_.g_label()));
+	CommandPalette::entries.push_back(std::move(entry_));
+	CommandPalette::seenStamps.push_back(CommandPalette::syncStamp);
+	return tempId;
+}
+
+void CommandPalette::remove(const uint32_t& id_){
+	CommandPalette::index.remove(id_);
+	CommandPalette::entries.at(id_) = PaletteEntry();
+}
+
+void CommandPalette::rebuild(){
+	std::vector<PaletteEntry> tempOld;
+	tempOld.swap(CommandPalette::entries);
+	std::vector<uint32_t> tempRemap(tempOld.size(), 0);
+	CommandPalette::index.clear();
+	CommandPalette::seenStamps.clear();
+	for (size_t i = 0; i < tempOld.size(); i++){
+		// Tombstones were reset to a default entry, which has no label.
+		if (tempOld[i].g_label() == nullptr) continue;
+		tempRemap[i] = CommandPalette::add(std::move(tempOld[i]));
+	}
+	for (auto& Ii : CommandPalette::actorIds) Ii.second = tempRemap[Ii.second];
+}
+
+void CommandPalette::sync(const ActorList& roster_, const uint64_t& revision_){
+	if (!CommandPalette::fixedIndexed){
+		for (ActorAction Ai = ActorAction::Move; Ai < ActorAction::END_OF_LIST; Ai++){
+			PaletteEntry tempEntry;
+			tempEntry.kind = PaletteKind::Action;
+			tempEntry.label = ActionsData::g_data(Ai).g_name().c_str();
+			tempEntry.action = Ai;
+			CommandPalette::add(std::move(tempEntry));
+		}
+		for (size_t i = 0; i < static_cast<size_t>(PaletteCommand::END_OF_LIST); i++){
+			PaletteEntry tempEntry;
+			tempEntry.kind = PaletteKind::Command;
+			tempEntry.label = commandNames[i];
+			tempEntry.command = static_cast<PaletteCommand>(i);
+			CommandPalette::add(std::move(tempEntry));
+		}
+		CommandPalette::fixedIndexed = true;
+	}
+	if (revision_ == CommandPalette::syncedRevision) return;
+	CommandPalette::syncedRevision = revision_;
+	CommandPalette::syncStamp++;
+
+	for (const auto& Ai : roster_){
+		const auto tempFound = CommandPalette::actorIds.find(Ai.get());
+		if (tempFound != CommandPalette::actorIds.end()){
+			// Same address and label version, and the entry's actor is still this one (slots are pooled).
+			const PaletteEntry& tempEntry = CommandPalette::entries[tempFound->second];
+			if (tempEntry.labelVersion == Ai->g_label_version() && tempEntry.actor.lock() == Ai){
+				CommandPalette::seenStamps[tempFound->second] = CommandPalette::syncStamp;
+				continue;
+			}
+			CommandPalette::remove(tempFound->second);
+		}
+		PaletteEntry tempEntry;
+		tempEntry.kind = PaletteKind::Actor;
+		tempEntry.actorLabel = Ai->g_label();
+		tempEntry.labelVersion = Ai->g_label_version();
+		tempEntry.actor = Ai;
+		CommandPalette::actorIds[Ai.get()] = CommandPalette::add(std::move(tempEntry));
+	}
+	for (auto Ii = CommandPalette::actorIds.begin(); Ii != CommandPalette::actorIds.end();){
+		if (CommandPalette::seenStamps[Ii->second] != CommandPalette::syncStamp){
+			CommandPalette::remove(Ii->second);
+			Ii = CommandPalette::actorIds.erase(Ii);
+		}
+		else ++Ii;
+	}
+	const size_t tempDead = CommandPalette::entries.size() - CommandPalette::index.g_live();
+	if (tempDead >= rebuildMinimum && tempDead > CommandPalette::index.g_live()) CommandPalette::rebuild();
+}
+
+void CommandPalette::clear(){
+	CommandPalette::index.clear();
+	CommandPalette::entries.clear();
+	CommandPalette::seenStamps.clear();
+	CommandPalette::actorIds.clear();
+	CommandPalette::syncedRevision = ~0ull;
+	CommandPalette::fixedIndexed = false;
+}
+
+void CommandPalette::search(const char* query_, const size_t& maxResults_, std::vector<uint32_t>& results_){
+	CommandPalette::index.search(query_, maxResults_, results_);
+}
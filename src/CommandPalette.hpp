@@ -0,0 +1,83 @@
+#ifndef _COMMAND_PALETTE_HPP_
+#define _COMMAND_PALETTE_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "ActorSlot.hpp"
+#include "TrigramIndex.hpp"
+
+
+enum class PaletteKind {
+	Actor,
+	Action,
+	Command
+};
+
+enum class PaletteCommand {
+	Roll_All,
+	Roll_Enemies,
+	Roll_Players,
+	Next_Turn,
+	Show_Body,
+	END_OF_LIST
+};
+
+struct PaletteEntry {
+	PaletteKind kind{PaletteKind::Command};
+	const char* label{nullptr};				// action and command names
+	std::string actorLabel;					// copied, actor labels live in their slot
+	uint64_t labelVersion{0};
+	std::weak_ptr<ActorSlot> actor;
+	ActorAction action{ActorAction::None};
+	PaletteCommand command{PaletteCommand::END_OF_LIST};
+
+	const char* g_label() const { return this->kind == PaletteKind::Actor ? this->actorLabel.c_str() : this->label; }
+};
+
+
+// Fuzzy index behind the Ctrl+K palette: actor labels, action names and panel commands.
+// Actions and commands are indexed once. Actors follow the roster through sync(), which
+// only adds the actors it hasn't seen and tombstones the ones that left or were relabelled.
+// Index ids are never reused, so once the tombstones outnumber the live entries the live
+// ones are re-added under fresh ids and the old records go.
+class CommandPalette {
+private:
+	static TrigramIndex index;
+	static std::vector<PaletteEntry> entries;
+	static std::vector<uint64_t> seenStamps;
+	static std::unordered_map<const ActorSlot*, uint32_t> actorIds;
+	static uint64_t syncedRevision;
+	static uint64_t syncStamp;
+	static bool fixedIndexed;
+
+	static uint32_t add(PaletteEntry&& entry_);
+	static void remove(const uint32_t& id_);
+	static void rebuild();
+
+	CommandPalette(){}
+
+public:
+	static const char* g_command_name(const PaletteCommand& command_);
+
+	// Returns at once while revision_ is the one of the last sync.
+	static void sync(const ActorList& roster_, const uint64_t& revision_);
+	// Next sync() walks the roster whatever the revision, e.g. when the palette opens.
+	static void invalidate() { CommandPalette::syncedRevision = ~0ull; }
+	static void clear();
+
+	// Entry ids, best matches first.
+	static void search(const char* query_, const size_t& maxResults_, std::vector<uint32_t>& results_);
+	static const PaletteEntry& g_entry(const uint32_t& id_) { return CommandPalette::entries.at(id_); }
+	static size_t g_live() { return CommandPalette::index.g_live(); }
+	// Entries ever added, tombstones included.
+	static size_t size() { return CommandPalette::entries.size(); }
+};
+
+
+
+#endif
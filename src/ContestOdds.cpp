@@ -0,0 +1,82 @@
+#include "ContestOdds.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+// Sized once: g_odds holds a reference into one distribution while building the other.
+std::vector<std::vector<double>> ContestOdds::bestSets(static_cast<size_t>(ContestOdds::maxPool) + 1);
+std::unordered_map<uint32_t, ContestResult> ContestOdds::results;
+
+
+// Ways to roll n_ dice with face f showing at most caps_[f] times, divided by n_!.
+static double capped_count(const int& n_, const int* caps_, const size_t& faces_, std::vector<double>& poly_, std::vector<double>& next_, const std::vector<double>& invFactorials_){
+	const size_t tempDegree = static_cast<size_t>(n_);
+	std::fill(poly_.begin(), poly_.end(), 0.0);
+	poly_[0] = 1.0;
+	size_t tempTop = 0;
+	for (size_t f = 0; f < faces_; f++){
+		const size_t tempCap = static_cast<size_t>(std::max(0, caps_[f]));
+		const size_t tempNewTop = std::min(tempDegree, tempTop + tempCap);
+		std::fill(next_.begin(), next_.begin() + static_cast<std::ptrdiff_t>(tempNewTop + 1), 0.0);
+		for (size_t i = 0; i <= tempTop; i++){
+			if (poly_[i] == 0.0) continue;
+			for (size_t k = 0; k <= tempCap && i + k <= tempDegree; k++) next_[i + k] += poly_[i] * invFactorials_[k];
+		}
+		std::swap(poly_, next_);
+		tempTop = tempNewTop;
+	}
+	return tempTop == tempDegree ? poly_[tempDegree] : 0.0;
+}
+
+const std::vector<double>& ContestOdds::g_best_set(int pool_){
+	pool_ = std::max(0, std::min(pool_, static_cast<int>(maxPool)));
+	std::vector<double>& tempDist = ContestOdds::bestSets[static_cast<size_t>(pool_)];
+	if (!tempDist.empty()) return tempDist;
+
+	const size_t tempOutcomes = ContestOdds::g_outcome(std::max(pool_, 2), static_cast<int>(faces)) + 1;
+	tempDist.assign(tempOutcomes, 0.0);
+	if (pool_ < 2) { tempDist[0] = 1.0; return tempDist; }
+
+	std::vector<double> tempInvFactorials(static_cast<size_t>(pool_) + 1, 1.0);
+	for (size_t k = 1; k < tempInvFactorials.size(); k++) tempInvFactorials[k] = tempInvFactorials[k - 1] / static_cast<double>(k);
+	// n! / 10^n, built up together so neither side overflows.
+	double tempScale = 1.0;
+	for (int k = 1; k <= pool_; k++) tempScale *= static_cast<double>(k) / static_cast<double>(faces);
+
+	std::vector<double> tempPoly(static_cast<size_t>(pool_) + 1), tempNext(static_cast<size_t>(pool_) + 1);
+	int tempCaps[faces];
+	double tempPrevious = 0.0;
+	for (size_t o = 0; o < tempOutcomes; o++){
+		// Best set at most outcome o: width w up to face h, w - 1 above; no set means every face at most once.
+		const int tempWidth = o == 0 ? 1 : static_cast<int>((o - 1) / faces) + 2;
+		const size_t tempHeight = o == 0 ? faces : (o - 1) % faces + 1;
+		for (size_t f = 0; f < faces; f++) tempCaps[f] = f < tempHeight ? tempWidth : tempWidth - 1;
+		const double tempCdf = std::min(1.0, capped_count(pool_, tempCaps, static_cast<size_t>(faces), tempPoly, tempNext, tempInvFactorials) * tempScale);
+		tempDist[o] = std::max(0.0, tempCdf - tempPrevious);
+		tempPrevious = tempCdf;
+	}
+	return tempDist;
+}
+
+const ContestResult& ContestOdds::g_odds(int poolA_, int poolB_){
+	poolA_ = std::max(0, std::min(poolA_, static_cast<int>(maxPool)));
+	poolB_ = std::max(0, std::min(poolB_, static_cast<int>(maxPool)));
+	const uint32_t tempKey = static_cast<uint32_t>(poolA_) << 16 | static_cast<uint32_t>(poolB_);
+	const auto tempFound = ContestOdds::results.find(tempKey);
+	if (tempFound != ContestOdds::results.end()) return tempFound->second;
+
+	const std::vector<double>& tempA = ContestOdds::g_best_set(poolA_);
+	const std::vector<double>& tempB = ContestOdds::g_best_set(poolB_);
+	ContestResult tempResult;
+	// Running sum of B below the current outcome of A; no set against no set is a tie.
+	double tempBelow = 0.0;
+	for (size_t o = 0; o < tempA.size(); o++){
+		const double tempSame = o < tempB.size() ? tempB[o] : 0.0;
+		tempResult.win += tempA[o] * tempBelow;
+		tempResult.tie += tempA[o] * tempSame;
+		tempBelow += tempSame;
+	}
+	tempResult.lose = std::max(0.0, 1.0 - tempResult.win - tempResult.tie);
+	return ContestOdds::results.emplace(tempKey, tempResult).first->second;
+}
@@ -0,0 +1,44 @@
+#ifndef _CONTEST_ODDS_HPP_
+#define _CONTEST_ODDS_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+
+struct ContestResult {
+	double win{0.0};
+	double tie{0.0};
+	double lose{0.0};
+};
+
+
+// Exact odds of an opposed roll. Each side rolls its pool of d10 and keeps its best set,
+// widest first and then highest; a pool without a pair has no set and loses to any set.
+// The best set distribution of n dice comes from counting rolls with every face capped:
+// P(best <= (w, h)) is n! / 10^n times the x^n coefficient of the product of the
+// truncated exponentials sum_k<=cap x^k / k!, one per face. The cap is w for faces up
+// to h and w - 1 above. Both distributions and contest results are cached.
+class ContestOdds {
+private:
+	static const int maxPool = 64;
+	static const size_t faces = 10;
+
+	static std::vector<std::vector<double>> bestSets;
+	static std::unordered_map<uint32_t, ContestResult> results;
+
+	ContestOdds(){}
+
+public:
+	// Outcome index: 0 for no set, then (width - 2) * 10 + height for a set (height 1 to 10),
+	// so a higher index is a better set. Pools are clamped to [0, 64].
+	static size_t g_outcome(const int& width_, const int& height_) { return width_ < 2 ? 0 : static_cast<size_t>(width_ - 2) * faces + static_cast<size_t>(height_); }
+	static const std::vector<double>& g_best_set(int pool_);
+	static const ContestResult& g_odds(int poolA_, int poolB_);
+	static double g_set_chance(const int& pool_) { return 1.0 - ContestOdds::g_best_set(pool_).front(); }
+};
+
+
+
+#endif
@@ -0,0 +1,116 @@
+#include "DiceReservoir.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#elif defined(__linux__)
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+#include "rand.hpp"
+
+
+std::array<std::atomic<uint8_t>, DiceReservoir::capacity> DiceReservoir::faces;
+std::atomic<uint64_t> DiceReservoir::head{0};
+std::atomic<uint64_t> DiceReservoir::tail{0};
+std::atomic<uint64_t> DiceReservoir::drawn{0};
+std::atomic<uint64_t> DiceReservoir::underruns{0};
+std::atomic<uint64_t> DiceReservoir::underrunFaces{0};
+std::thread DiceReservoir::thread;
+std::atomic<bool> DiceReservoir::running{false};
+bool DiceReservoir::stopping{false};
+std::mutex DiceReservoir::wakeMutex;
+std::condition_variable DiceReservoir::wake;
+bool DiceReservoir::replay{false};
+std::mt19937 DiceReservoir::replayEngine;
+std::mutex DiceReservoir::replayMutex;
+
+
+static void lower_thread_priority(){
+#ifdef _WIN32
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__linux__)
+	sched_param tempParam{};
+	pthread_setschedparam(pthread_self(), SCHED_IDLE, &tempParam);
+#endif
+}
+
+void DiceReservoir::run(){
+	lower_thread_priority();
+	std::random_device tempDevice;
+	std::mt19937 tempEngine(tempDevice());
+	while (true){
+		// Only this thread moves tail; head may move on under it, which only frees more room.
+		const uint64_t tempTail = DiceReservoir::tail.load(std::memory_order_relaxed);
+		const uint64_t tempFree = capacity - (tempTail - DiceReservoir::head.load(std::memory_order_acquire));
+		for (uint64_t i = 0; i < tempFree; i++) DiceReservoir::faces[(tempTail + i) & (capacity - 1)].store(static_cast<uint8_t>(rand_int(tempEngine, 1, 10)), std::memory_order_relaxed);
+		DiceReservoir::tail.store(tempTail + tempFree, std::memory_order_release);
+
+		std::unique_lock<std::mutex> tempLock(DiceReservoir::wakeMutex);
+		// draw() notifies without the lock, the timeout covers a wakeup lost in between.
+		DiceReservoir::wake.wait_for(tempLock, std::chrono::milliseconds(50), [](){
+			return DiceReservoir::stopping || DiceReservoir::tail.load(std::memory_order_relaxed) - DiceReservoir::head.load(std::memory_order_relaxed) < refillBelow;
+		});
+		if (DiceReservoir::stopping) break;
+	}
+}
+
+void DiceReservoir::set_replay(const bool& replay_, const uint32_t& seed_){
+	std::lock_guard<std::mutex> tempLock(DiceReservoir::replayMutex);
+	DiceReservoir::replay = replay_;
+	DiceReservoir::replayEngine.seed(seed_);
+	if (replay_) std::cout << "DICE: seeded replay, seed " << seed_ << "\n";
+}
+
+void DiceReservoir::start(){
+	if (DiceReservoir::is_running() || DiceReservoir::replay) return;
+	DiceReservoir::stopping = false;
+	DiceReservoir::running.store(true, std::memory_order_relaxed);
+	DiceReservoir::thread = std::thread(&DiceReservoir::run);
+}
+
+void DiceReservoir::stop(){
+	if (!DiceReservoir::is_running()) return;
+	{
+		std::lock_guard<std::mutex> tempLock(DiceReservoir::wakeMutex);
+		DiceReservoir::stopping = true;
+	}
+	DiceReservoir::wake.notify_all();
+	DiceReservoir::thread.join();
+	DiceReservoir::running.store(false, std::memory_order_relaxed);
+	std::cout << "DICE: " << DiceReservoir::g_drawn() << " faces drawn, " << DiceReservoir::g_underruns() << " underruns ("
+		<< DiceReservoir::g_underrun_faces() << " faces rolled directly)\n";
+}
+
+void DiceReservoir::draw(int* faces_, const size_t& count_){
+	if (count_ == 0) return;
+	DiceReservoir::drawn.fetch_add(count_, std::memory_order_relaxed);
+	if (DiceReservoir::replay){
+		std::lock_guard<std::mutex> tempLock(DiceReservoir::replayMutex);
+		for (size_t i = 0; i < count_; i++) faces_[i] = rand_int(DiceReservoir::replayEngine, 1, 10);
+		return;
+	}
+
+	uint64_t tempHead = DiceReservoir::head.load(std::memory_order_acquire);
+	size_t tempTaken = 0;
+	while (true){
+		const uint64_t tempTail = DiceReservoir::tail.load(std::memory_order_acquire);
+		tempTaken = static_cast<size_t>(std::min<uint64_t>(count_, tempTail - tempHead));
+		for (size_t i = 0; i < tempTaken; i++) faces_[i] = DiceReservoir::faces[(tempHead + i) & (capacity - 1)].load(std::memory_order_relaxed);
+		// On failure tempHead is reloaded and the copy is redone from there.
+		if (DiceReservoir::head.compare_exchange_weak(tempHead, tempHead + tempTaken, std::memory_order_acq_rel, std::memory_order_acquire)) break;
+	}
+	if (DiceReservoir::is_running() && DiceReservoir::tail.load(std::memory_order_relaxed) - (tempHead + tempTaken) < refillBelow) DiceReservoir::wake.notify_one();
+	if (tempTaken == count_) return;
+
+	DiceReservoir::underruns.fetch_add(1, std::memory_order_relaxed);
+	DiceReservoir::underrunFaces.fetch_add(count_ - tempTaken, std::memory_order_relaxed);
+	thread_local std::mt19937 tempEngine(std::random_device{}());
+	for (size_t i = tempTaken; i < count_; i++) faces_[i] = rand_int(tempEngine, 1, 10);
+}
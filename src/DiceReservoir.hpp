@@ -0,0 +1,66 @@
+#ifndef _DICE_RESERVOIR_HPP_
+#define _DICE_RESERVOIR_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <random>
+
+
+// Pre-rolled d10 faces for ActorSlot::roll. One low priority thread keeps a ring topped
+// up from its own engine, seeded once from std::random_device, and any thread takes
+// faces in bulk without locking: a consumer copies a run and then claims it by moving
+// head with a CAS. If the CAS fails, the copy is thrown away and retried, because the
+// producer may already have refilled those slots.
+// A draw larger than what is left is an underrun; the missing faces come from a
+// thread-local engine. In seeded replay the ring is bypassed and every face comes from
+// one engine in call order, so the same seed always gives the same rolls on every platform.
+class DiceReservoir {
+private:
+	static const size_t capacity = 1 << 14;			// power of two
+	static const size_t refillBelow = capacity / 2;
+
+	static std::array<std::atomic<uint8_t>, capacity> faces;
+	static std::atomic<uint64_t> head;				// next face to draw
+	static std::atomic<uint64_t> tail;				// one past the last face written
+	static std::atomic<uint64_t> drawn;
+	static std::atomic<uint64_t> underruns;
+	static std::atomic<uint64_t> underrunFaces;
+
+	static std::thread thread;
+	static std::atomic<bool> running;
+	static bool stopping;
+	static std::mutex wakeMutex;
+	static std::condition_variable wake;
+
+	static bool replay;
+	static std::mt19937 replayEngine;
+	static std::mutex replayMutex;
+
+	DiceReservoir(){}
+
+	static void run();
+
+public:
+	// Call before start(); the thread isn't started while replay is on.
+	static void set_replay(const bool& replay_, const uint32_t& seed_ = 1);
+	static void start();
+	static void stop();
+	static bool is_running() { return DiceReservoir::running.load(std::memory_order_relaxed); }
+
+	// count_ faces from 1 to 10. Safe from any thread.
+	static void draw(int* faces_, const size_t& count_);
+
+	static uint64_t g_drawn() { return DiceReservoir::drawn.load(std::memory_order_relaxed); }
+	// Draws that found fewer faces than asked for, and the faces rolled directly for them.
+	static uint64_t g_underruns() { return DiceReservoir::underruns.load(std::memory_order_relaxed); }
+	static uint64_t g_underrun_faces() { return DiceReservoir::underrunFaces.load(std::memory_order_relaxed); }
+};
+
+
+
+#endif
@@ -0,0 +1,244 @@
+#include "FontCache.hpp"
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+
+#include "imgui_internal.h"
+
+#include "Bestiary.hpp"
+
+
+static const char fontCacheMagic[4] = {'M', 'H', 'F', 'C'};
+static const uint32_t fontCacheVersion = 1;
+
+struct FontCacheHeader {
+	char magic[4];
+	uint32_t version;
+	uint64_t key;
+	uint32_t width;
+	uint32_t height;
+	uint32_t fontCount;
+	uint32_t rectCount;
+	uint32_t pixelsSize;
+	uint64_t checksum;
+};
+
+struct FontCacheFont {
+	float ascent;
+	float descent;
+	int32_t metricsTotalSurface;
+	int32_t configDataCount;
+	uint32_t glyphCount;
+};
+
+struct FontCacheRect {
+	uint16_t x;
+	uint16_t y;
+};
+
+
+// Same word-at-a-time mix as FrameCache, the font data alone is a few hundred KB.
+static uint64_t hash_bytes(uint64_t hash_, const void* data_, const size_t& size_){
+	const unsigned char* tempBytes = static_cast<const unsigned char*>(data_);
+	size_t i = 0;
+	for (; i + 8 <= size_; i += 8){
+		uint64_t tempWord;
+		std::memcpy(&tempWord, tempBytes + i, 8);
+		hash_ = (hash_ ^ tempWord) * 0x9E3779B97F4A7C15ull;
+		hash_ ^= hash_ >> 29;
+	}
+	for (; i < size_; i++) hash_ = (hash_ ^ tempBytes[i]) * 0x100000001B3ull;
+	return hash_;
+}
+
+template<class T>
+static uint64_t hash_value(const uint64_t& hash_, const T& value_) { return hash_bytes(hash_, &value_, sizeof(T)); }
+
+uint64_t FontCache::key(const ImFontAtlas* atlas_){
+	uint64_t tempHash = 0xCBF29CE484222325ull;
+	tempHash = hash_value(tempHash, static_cast<int>(IMGUI_VERSION_NUM));
+	tempHash = hash_value(tempHash, atlas_->Flags);
+	tempHash = hash_value(tempHash, atlas_->TexDesiredWidth);
+	tempHash = hash_value(tempHash, atlas_->TexGlyphPadding);
+	tempHash = hash_value(tempHash, atlas_->Fonts.Size);
+	for (const ImFontConfig& Ci : atlas_->ConfigData){
+		tempHash = hash_bytes(tempHash, Ci.FontData, static_cast<size_t>(Ci.FontDataSize));
+		tempHash = hash_value(tempHash, Ci.FontNo);
+		tempHash = hash_value(tempHash, Ci.SizePixels);
+		tempHash = hash_value(tempHash, Ci.OversampleH);
+		tempHash = hash_value(tempHash, Ci.OversampleV);
+		tempHash = hash_value(tempHash, Ci.PixelSnapH);
+		tempHash = hash_value(tempHash, Ci.GlyphExtraSpacing);
+		tempHash = hash_value(tempHash, Ci.GlyphOffset);
+		tempHash = hash_value(tempHash, Ci.GlyphMinAdvanceX);
+		tempHash = hash_value(tempHash, Ci.GlyphMaxAdvanceX);
+		tempHash = hash_value(tempHash, Ci.MergeMode);
+		tempHash = hash_value(tempHash, Ci.RasterizerFlags);
+		tempHash = hash_value(tempHash, Ci.RasterizerMultiply);
+		tempHash = hash_value(tempHash, Ci.EllipsisChar);
+		tempHash = hash_value(tempHash, atlas_->Fonts.index_from_ptr(atlas_->Fonts.find(Ci.DstFont)));
+		const ImWchar* tempRanges = Ci.GlyphRanges ? Ci.GlyphRanges : const_cast<ImFontAtlas*>(atlas_)->GetGlyphRangesDefault();
+		for (; tempRanges[0]; tempRanges += 2) tempHash = hash_bytes(tempHash, tempRanges, 2 * sizeof(ImWchar));
+	}
+	return tempHash;
+}
+
+// Runs of zero bytes, then literal bytes: [u16 zeros][u16 literals][literals...], repeated.
+// Most of an atlas is empty space, and this decodes several times faster than inflate.
+void FontCache::compress(const unsigned char* pixels_, const size_t& size_, std::vector<unsigned char>& out_){
+	out_.clear();
+	size_t i = 0;
+	while (i < size_){
+		size_t tempZeros = 0;
+		while (i < size_ && pixels_[i] == 0 && tempZeros < 0xFFFF) { i++; tempZeros++; }
+		const size_t tempStart = i;
+		// A literal run ends at the next run of 4 zeros, shorter ones are cheaper inline.
+		while (i < size_ && i - tempStart < 0xFFFF){
+			if (pixels_[i] == 0 && i + 4 <= size_ && (pixels_[i + 1] | pixels_[i + 2] | pixels_[i + 3]) == 0) break;
+			i++;
+		}
+		const size_t tempLiterals = i - tempStart;
+		const unsigned char tempCounts[4] = {static_cast<unsigned char>(tempZeros), static_cast<unsigned char>(tempZeros >> 8), static_cast<unsigned char>(tempLiterals), static_cast<unsigned char>(tempLiterals >> 8)};
+		out_.insert(out_.end(), tempCounts, tempCounts + 4);
+		out_.insert(out_.end(), pixels_ + tempStart, pixels_ + i);
+	}
+}
+
+bool FontCache::decompress(const unsigned char* data_, const size_t& dataSize_, unsigned char* pixels_, const size_t& size_){
+	size_t tempIn = 0, tempOut = 0;
+	while (tempIn + 4 <= dataSize_){
+		const size_t tempZeros = data_[tempIn] | (data_[tempIn + 1] << 8);
+		const size_t tempLiterals = data_[tempIn + 2] | (data_[tempIn + 3] << 8);
+		tempIn += 4;
+		if (tempOut + tempZeros + tempLiterals > size_ || tempIn + tempLiterals > dataSize_) return false;
+		std::memset(pixels_ + tempOut, 0, tempZeros);
+		std::memcpy(pixels_ + tempOut + tempZeros, data_ + tempIn, tempLiterals);
+		tempOut += tempZeros + tempLiterals;
+		tempIn += tempLiterals;
+	}
+	return tempIn == dataSize_ && tempOut == size_;
+}
+
+bool FontCache::load(ImFontAtlas* atlas_, const std::string& path_, const uint64_t& key_){
+	MappedFile tempFile;
+	if (!tempFile.open(path_)) return false;
+	const char* tempData = tempFile.g_data();
+	const size_t tempSize = tempFile.g_size();
+	size_t tempOffset = sizeof(FontCacheHeader);
+	if (tempSize < tempOffset) return false;
+	FontCacheHeader tempHeader;
+	std::memcpy(&tempHeader, tempData, sizeof(FontCacheHeader));
+	if (std::memcmp(tempHeader.magic, fontCacheMagic, 4) != 0 || tempHeader.version != fontCacheVersion || tempHeader.key != key_) return false;
+	if (tempHeader.fontCount != static_cast<uint32_t>(atlas_->Fonts.Size)) return false;
+	if (hash_bytes(tempHeader.key, tempData + tempOffset, tempSize - tempOffset) != tempHeader.checksum) return false;
+
+	// Everything is read and checked before the atlas is touched.
+	std::vector<FontCacheFont> tempFonts(tempHeader.fontCount);
+	std::vector<size_t> tempGlyphOffsets(tempHeader.fontCount);
+	for (uint32_t i = 0; i < tempHeader.fontCount; i++){
+		if (tempSize < tempOffset + sizeof(FontCacheFont)) return false;
+		std::memcpy(&tempFonts[i], tempData + tempOffset, sizeof(FontCacheFont));
+		tempGlyphOffsets[i] = tempOffset + sizeof(FontCacheFont);
+		tempOffset = tempGlyphOffsets[i] + tempFonts[i].glyphCount * sizeof(ImFontGlyph);
+	}
+	std::vector<FontCacheRect> tempRects(tempHeader.rectCount);
+	if (tempSize < tempOffset + tempRects.size() * sizeof(FontCacheRect) + tempHeader.pixelsSize) return false;
+	if (!tempRects.empty()) std::memcpy(tempRects.data(), tempData + tempOffset, tempRects.size() * sizeof(FontCacheRect));
+	tempOffset += tempRects.size() * sizeof(FontCacheRect);
+	const size_t tempPixelCount = static_cast<size_t>(tempHeader.width) * tempHeader.height;
+	unsigned char* tempPixels = static_cast<unsigned char*>(IM_ALLOC(tempPixelCount));
+	if (!FontCache::decompress(reinterpret_cast<const unsigned char*>(tempData + tempOffset), tempHeader.pixelsSize, tempPixels, tempPixelCount)){
+		IM_FREE(tempPixels);
+		return false;
+	}
+
+	atlas_->ClearTexData();
+	ImFontAtlasBuildInit(atlas_);
+	bool tempRectsMatch = atlas_->CustomRects.Size == static_cast<int>(tempRects.size());
+	for (int i = 0; tempRectsMatch && i < atlas_->CustomRects.Size; i++) tempRectsMatch = atlas_->CustomRects[i].Font == nullptr;
+	if (!tempRectsMatch){
+		IM_FREE(tempPixels);
+		return false;
+	}
+	atlas_->TexWidth = static_cast<int>(tempHeader.width);
+	atlas_->TexHeight = static_cast<int>(tempHeader.height);
+	atlas_->TexUvScale = ImVec2(1.0f / atlas_->TexWidth, 1.0f / atlas_->TexHeight);
+	atlas_->TexPixelsAlpha8 = tempPixels;
+	for (size_t i = 0; i < tempRects.size(); i++){
+		atlas_->CustomRects[static_cast<int>(i)].X = tempRects[i].x;
+		atlas_->CustomRects[static_cast<int>(i)].Y = tempRects[i].y;
+	}
+	for (ImFontConfig& Ci : atlas_->ConfigData){
+		const FontCacheFont& tempFont = tempFonts[static_cast<size_t>(atlas_->Fonts.index_from_ptr(atlas_->Fonts.find(Ci.DstFont)))];
+		ImFontAtlasBuildSetupFont(atlas_, Ci.DstFont, &Ci, tempFont.ascent, tempFont.descent);
+	}
+	for (int i = 0; i < atlas_->Fonts.Size; i++){
+		ImFont* tempFont = atlas_->Fonts[i];
+		tempFont->Glyphs.resize(static_cast<int>(tempFonts[static_cast<size_t>(i)].glyphCount));
+		if (!tempFont->Glyphs.empty()) std::memcpy(tempFont->Glyphs.Data, tempData + tempGlyphOffsets[static_cast<size_t>(i)], tempFont->Glyphs.size_in_bytes());
+		tempFont->MetricsTotalSurface = tempFonts[static_cast<size_t>(i)].metricsTotalSurface;
+		// Merged sources that added no glyphs are skipped by the stb_truetype builder.
+		tempFont->ConfigDataCount = tempFonts[static_cast<size_t>(i)].configDataCount;
+		tempFont->DirtyLookupTables = true;
+	}
+	ImFontAtlasBuildFinish(atlas_);
+	return true;
+}
+
+bool FontCache::save(const ImFontAtlas* atlas_, const std::string& path_, const uint64_t& key_){
+	if (atlas_->TexPixelsAlpha8 == nullptr) return false;
+	std::vector<unsigned char> tempPixels;
+	FontCache::compress(atlas_->TexPixelsAlpha8, static_cast<size_t>(atlas_->TexWidth) * atlas_->TexHeight, tempPixels);
+	if (tempPixels.empty()) return false;
+
+	FontCacheHeader tempHeader;
+	std::memcpy(tempHeader.magic, fontCacheMagic, 4);
+	tempHeader.version = fontCacheVersion;
+	tempHeader.key = key_;
+	tempHeader.width = static_cast<uint32_t>(atlas_->TexWidth);
+	tempHeader.height = static_cast<uint32_t>(atlas_->TexHeight);
+	tempHeader.fontCount = static_cast<uint32_t>(atlas_->Fonts.Size);
+	tempHeader.rectCount = static_cast<uint32_t>(atlas_->CustomRects.Size);
+	tempHeader.pixelsSize = static_cast<uint32_t>(tempPixels.size());
+
+	std::vector<unsigned char> tempPayload;
+	const auto tempAppend = [&tempPayload](const void* data_, const size_t& size_){
+		tempPayload.insert(tempPayload.end(), static_cast<const unsigned char*>(data_), static_cast<const unsigned char*>(data_) + size_);
+	};
+	for (const ImFont* Fi : atlas_->Fonts){
+		const FontCacheFont tempFont{Fi->Ascent, Fi->Descent, Fi->MetricsTotalSurface, Fi->ConfigDataCount, static_cast<uint32_t>(Fi->Glyphs.Size)};
+		tempAppend(&tempFont, sizeof(FontCacheFont));
+		tempAppend(Fi->Glyphs.Data, Fi->Glyphs.size_in_bytes());
+	}
+	for (const ImFontAtlasCustomRect& Ri : atlas_->CustomRects){
+		const FontCacheRect tempRect{Ri.X, Ri.Y};
+		tempAppend(&tempRect, sizeof(FontCacheRect));
+	}
+	tempAppend(tempPixels.data(), tempPixels.size());
+	tempHeader.checksum = hash_bytes(key_, tempPayload.data(), tempPayload.size());
+
+	const std::string tempPath = path_ + ".tmp";
+	FILE* tempFile = std::fopen(tempPath.c_str(), "wb");
+	if (tempFile == nullptr) return false;
+	bool tempOk = std::fwrite(&tempHeader, sizeof(FontCacheHeader), 1, tempFile) == 1;
+	tempOk = tempOk && std::fwrite(tempPayload.data(), 1, tempPayload.size(), tempFile) == tempPayload.size();
+	tempOk = (std::fclose(tempFile) == 0) && tempOk;
+	std::remove(path_.c_str());
+	if (!tempOk || std::rename(tempPath.c_str(), path_.c_str()) != 0){
+		std::remove(tempPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool FontCache::build(ImFontAtlas* atlas_, const std::string& path_){
+	const uint64_t tempKey = FontCache::key(atlas_);
+	if (FontCache::load(atlas_, path_, tempKey)) return true;
+	atlas_->Build();
+	bool tempCustomGlyphs = false;
+	for (const ImFontAtlasCustomRect& Ri : atlas_->CustomRects) tempCustomGlyphs |= Ri.Font != nullptr;
+	// Glyphs backed by custom rects are added again by every build, they can't be restored from a table.
+	if (!tempCustomGlyphs && !FontCache::save(atlas_, path_, tempKey)) std::cout << "FONTCACHE: failed to write " << path_ << "\n";
+	return false;
+}
@@ -0,0 +1,34 @@
+#ifndef _FONT_CACHE_HPP_
+#define _FONT_CACHE_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "imgui.h"
+
+
+// Baked font atlas on disk: glyph tables, custom rect positions and the run-length coded
+// Alpha8 pixels, keyed by the font data, sizes, ranges and build settings of the atlas.
+// A hit skips stb_truetype rasterization entirely.
+class FontCache {
+private:
+	static uint64_t key(const ImFontAtlas* atlas_);
+	static bool load(ImFontAtlas* atlas_, const std::string& path_, const uint64_t& key_);
+	static bool save(const ImFontAtlas* atlas_, const std::string& path_, const uint64_t& key_);
+
+	static void compress(const unsigned char* pixels_, const size_t& size_, std::vector<unsigned char>& out_);
+	static bool decompress(const unsigned char* data_, const size_t& dataSize_, unsigned char* pixels_, const size_t& size_);
+
+	FontCache(){}
+
+public:
+	// Fonts must already be added to atlas_. Loads it from path_ when the key matches,
+	// otherwise builds it and rewrites path_. Returns true on a cache hit.
+	static bool build(ImFontAtlas* atlas_, const std::string& path_);
+};
+
+
+
+#endif
@@ -0,0 +1,162 @@
+#include "FrameCache.hpp"
+
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#include "imgui_impl_opengl3.h"
+
+
+GLuint FrameCache::framebuffer{0};
+GLuint FrameCache::colorBuffer{0};
+int FrameCache::width{0};
+int FrameCache::height{0};
+bool FrameCache::valid{false};
+bool FrameCache::failed{false};
+std::vector<FrameCache::ListState> FrameCache::lists;
+std::vector<FrameCache::ListState> FrameCache::listsNext;
+uint64_t FrameCache::framesFull{0};
+uint64_t FrameCache::framesPartial{0};
+uint64_t FrameCache::framesReused{0};
+
+
+static uint64_t hash_bytes(uint64_t hash_, const void* data_, const size_t& length_){
+	const unsigned char* tempBytes = static_cast<const unsigned char*>(data_);
+	size_t i = 0;
+	for (; i + 8 <= length_; i += 8){
+		uint64_t tempWord;
+		std::memcpy(&tempWord, tempBytes + i, 8);
+		hash_ = (hash_ ^ tempWord) * 0x9E3779B97F4A7C15ull;
+		hash_ ^= hash_ >> 29;
+	}
+	for (; i < length_; i++) hash_ = (hash_ ^ tempBytes[i]) * 0x100000001B3ull;
+	return hash_;
+}
+
+uint64_t FrameCache::hash_list(const ImDrawList* list_){
+	uint64_t tempHash = 0xCBF29CE484222325ull;
+	tempHash = hash_bytes(tempHash, list_->VtxBuffer.Data, static_cast<size_t>(list_->VtxBuffer.Size) * sizeof(ImDrawVert));
+	tempHash = hash_bytes(tempHash, list_->IdxBuffer.Data, static_cast<size_t>(list_->IdxBuffer.Size) * sizeof(ImDrawIdx));
+	for (const ImDrawCmd& Ci : list_->CmdBuffer){
+		tempHash = hash_bytes(tempHash, &Ci.ClipRect, sizeof(Ci.ClipRect));
+		tempHash = hash_bytes(tempHash, &Ci.TextureId, sizeof(Ci.TextureId));
+		tempHash = hash_bytes(tempHash, &Ci.VtxOffset, sizeof(Ci.VtxOffset));
+		tempHash = hash_bytes(tempHash, &Ci.IdxOffset, sizeof(Ci.IdxOffset));
+		tempHash = hash_bytes(tempHash, &Ci.ElemCount, sizeof(Ci.ElemCount));
+		tempHash = hash_bytes(tempHash, &Ci.UserCallback, sizeof(Ci.UserCallback));
+	}
+	return tempHash;
+}
+
+// Everything a list draws is inside the union of its clip rectangles.
+ImVec4 FrameCache::list_bounds(const ImDrawList* list_, const ImDrawData* drawData_){
+	ImVec4 tempBounds{drawData_->DisplayPos.x + drawData_->DisplaySize.x, drawData_->DisplayPos.y + drawData_->DisplaySize.y, drawData_->DisplayPos.x, drawData_->DisplayPos.y};
+	for (const ImDrawCmd& Ci : list_->CmdBuffer){
+		if (Ci.ElemCount == 0 && Ci.UserCallback == nullptr) continue;
+		tempBounds.x = std::min(tempBounds.x, Ci.ClipRect.x);
+		tempBounds.y = std::min(tempBounds.y, Ci.ClipRect.y);
+		tempBounds.z = std::max(tempBounds.z, Ci.ClipRect.z);
+		tempBounds.w = std::max(tempBounds.w, Ci.ClipRect.w);
+	}
+	return tempBounds;
+}
+
+bool FrameCache::resize(const int& width_, const int& height_){
+	// Blitting into a multisampled window is not allowed.
+	GLint tempSamples = 0;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glGetIntegerv(GL_SAMPLE_BUFFERS, &tempSamples);
+	if (tempSamples > 0) return false;
+	if (!FrameCache::framebuffer) glGenFramebuffers(1, &FrameCache::framebuffer);
+	if (!FrameCache::colorBuffer) glGenRenderbuffers(1, &FrameCache::colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, FrameCache::colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width_, height_);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, FrameCache::framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, FrameCache::colorBuffer);
+	const bool tempComplete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	FrameCache::width = width_;
+	FrameCache::height = height_;
+	FrameCache::valid = false;
+	return tempComplete;
+}
+
+void FrameCache::render(ImDrawData* drawData_){
+	const int tempWidth = static_cast<int>(drawData_->DisplaySize.x * drawData_->FramebufferScale.x);
+	const int tempHeight = static_cast<int>(drawData_->DisplaySize.y * drawData_->FramebufferScale.y);
+	if (tempWidth <= 0 || tempHeight <= 0) return;
+	if (!FrameCache::failed && (tempWidth != FrameCache::width || tempHeight != FrameCache::height) && !FrameCache::resize(tempWidth, tempHeight)){
+		std::cout << "FRAMECACHE: no usable offscreen framebuffer, drawing every frame directly\n";
+		FrameCache::failed = true;
+	}
+	if (FrameCache::failed){
+		ImGui_ImplOpenGL3_RenderDrawData(drawData_);
+		return;
+	}
+
+	bool tempFull = !FrameCache::valid || static_cast<size_t>(drawData_->CmdListsCount) != FrameCache::lists.size();
+	ImVec4 tempDirty{drawData_->DisplayPos.x + drawData_->DisplaySize.x, drawData_->DisplayPos.y + drawData_->DisplaySize.y, drawData_->DisplayPos.x, drawData_->DisplayPos.y};
+	FrameCache::listsNext.resize(static_cast<size_t>(drawData_->CmdListsCount));
+	for (size_t i = 0; i < FrameCache::listsNext.size(); i++){
+		auto& tempList = FrameCache::listsNext[i];
+		tempList.hash = FrameCache::hash_list(drawData_->CmdLists[i]);
+		tempList.bounds = FrameCache::list_bounds(drawData_->CmdLists[i], drawData_);
+		if (tempFull || tempList.hash == FrameCache::lists[i].hash) continue;
+		for (const ImVec4& Bi : {tempList.bounds, FrameCache::lists[i].bounds}){
+			tempDirty.x = std::min(tempDirty.x, Bi.x);
+			tempDirty.y = std::min(tempDirty.y, Bi.y);
+			tempDirty.z = std::max(tempDirty.z, Bi.z);
+			tempDirty.w = std::max(tempDirty.w, Bi.w);
+		}
+	}
+	FrameCache::lists.swap(FrameCache::listsNext);
+
+	// Dirty area in whole pixels, so the scissored clear and the clipped redraw cover the same area.
+	const ImVec2 tempScale = drawData_->FramebufferScale;
+	const ImVec2 tempOrigin = drawData_->DisplayPos;
+	const int tempX0 = std::max(0, static_cast<int>(std::floor((tempDirty.x - tempOrigin.x) * tempScale.x)));
+	const int tempY0 = std::max(0, static_cast<int>(std::floor((tempDirty.y - tempOrigin.y) * tempScale.y)));
+	const int tempX1 = std::min(tempWidth, static_cast<int>(std::ceil((tempDirty.z - tempOrigin.x) * tempScale.x)));
+	const int tempY1 = std::min(tempHeight, static_cast<int>(std::ceil((tempDirty.w - tempOrigin.y) * tempScale.y)));
+
+	glBindFramebuffer(GL_FRAMEBUFFER, FrameCache::framebuffer);
+	if (tempFull){
+		glClear(GL_COLOR_BUFFER_BIT);
+		ImGui_ImplOpenGL3_RenderDrawData(drawData_);
+		FrameCache::framesFull++;
+	}
+	else if (tempX1 > tempX0 && tempY1 > tempY0){
+		const ImVec4 tempClip{tempOrigin.x + tempX0 / tempScale.x, tempOrigin.y + tempY0 / tempScale.y, tempOrigin.x + tempX1 / tempScale.x, tempOrigin.y + tempY1 / tempScale.y};
+		glEnable(GL_SCISSOR_TEST);
+		glScissor(tempX0, tempHeight - tempY1, tempX1 - tempX0, tempY1 - tempY0);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glDisable(GL_SCISSOR_TEST);
+		ImGui_ImplOpenGL3_SetClipOverride(&tempClip);
+		ImGui_ImplOpenGL3_RenderDrawData(drawData_);
+		ImGui_ImplOpenGL3_SetClipOverride(nullptr);
+		FrameCache::framesPartial++;
+	}
+	else FrameCache::framesReused++;
+	FrameCache::valid = true;
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, FrameCache::framebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	glBlitFramebuffer(0, 0, tempWidth, tempHeight, 0, 0, tempWidth, tempHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void FrameCache::destroy(){
+	FrameCache::report();
+	if (FrameCache::framebuffer) glDeleteFramebuffers(1, &FrameCache::framebuffer);
+	if (FrameCache::colorBuffer) glDeleteRenderbuffers(1, &FrameCache::colorBuffer);
+	FrameCache::framebuffer = 0;
+	FrameCache::colorBuffer = 0;
+	FrameCache::width = FrameCache::height = 0;
+	FrameCache::valid = false;
+}
+
+void FrameCache::report(){
+	std::cout << "FRAMECACHE: " << FrameCache::framesFull << " full, " << FrameCache::framesPartial << " partial, " << FrameCache::framesReused << " reused frames\n";
+}
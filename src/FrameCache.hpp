@@ -0,0 +1,51 @@
+#ifndef _FRAME_CACHE_HPP_
+#define _FRAME_CACHE_HPP_
+
+#include <vector>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include "imgui.h"
+
+
+// Retained UI framebuffer. Every draw list is hashed after ImGui::Render(): an unchanged
+// frame is re-presented from the offscreen copy without submitting anything, and a frame
+// where only some lists changed is redrawn scissored to their old and new bounds.
+class FrameCache {
+private:
+	struct ListState {
+		uint64_t hash;
+		ImVec4 bounds;
+	};
+
+	static GLuint framebuffer;
+	static GLuint colorBuffer;
+	static int width;
+	static int height;
+	static bool valid;
+	static bool failed;
+	static std::vector<ListState> lists;
+	static std::vector<ListState> listsNext;
+	static uint64_t framesFull;
+	static uint64_t framesPartial;
+	static uint64_t framesReused;
+
+	FrameCache(){}
+
+	static bool resize(const int& width_, const int& height_);
+	static uint64_t hash_list(const ImDrawList* list_);
+	static ImVec4 list_bounds(const ImDrawList* list_, const ImDrawData* drawData_);
+
+public:
+	// Brings the offscreen copy up to date with drawData_ and blits it to the default framebuffer.
+	static void render(ImDrawData* drawData_);
+	// Next render() redraws everything, e.g. after the GL context or the font texture changed.
+	static void invalidate() { FrameCache::valid = false; }
+	static void destroy();
+	static void report();
+};
+
+
+
+#endif
@@ -0,0 +1,93 @@
+#include "FramePacer.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+
+bool FramePacer::enabled{false};
+double FramePacer::period{1.0 / 60.0};
+double FramePacer::lastSwap{-1.0};
+double FramePacer::targetVblank{-1.0};
+double FramePacer::workStart{-1.0};
+double FramePacer::workMean{0.002};
+double FramePacer::workVariance{0.0};
+double FramePacer::missPenalty{0.0};
+double FramePacer::margin{0.004};
+uint64_t FramePacer::framesPaced{0};
+uint64_t FramePacer::framesMissed{0};
+
+static const double workSmoothing = 0.1;
+static const double periodSmoothing = 0.05;
+static const double marginSafety = 0.0005;
+static const double missStep = 0.001;
+
+void FramePacer::init(GLFWwindow* window_, const bool& enabled_){
+	FramePacer::enabled = enabled_;
+	if (!enabled_) return;
+	GLFWmonitor* tempMonitor = glfwGetWindowMonitor(window_);
+	if (tempMonitor == nullptr) tempMonitor = glfwGetPrimaryMonitor();
+	const GLFWvidmode* tempMode = tempMonitor ? glfwGetVideoMode(tempMonitor) : nullptr;
+	if (tempMode != nullptr && tempMode->refreshRate > 0) FramePacer::period = 1.0 / tempMode->refreshRate;
+	FramePacer::update_margin();
+	std::cout << "PACER: low latency mode, " << std::lround(1.0 / FramePacer::period) << " Hz\n";
+}
+
+void FramePacer::update_margin(){
+	FramePacer::margin = FramePacer::workMean + 3.0 * std::sqrt(FramePacer::workVariance) + marginSafety + FramePacer::missPenalty;
+	// Past most of a period there is nothing left to gain, just start right after the swap.
+	FramePacer::margin = std::min(FramePacer::margin, 0.9 * FramePacer::period);
+}
+
+void FramePacer::wait(){
+	if (!FramePacer::enabled) return;
+	double tempNow = glfwGetTime();
+	if (FramePacer::lastSwap < 0.0){
+		FramePacer::workStart = tempNow;
+		return;
+	}
+	// First vblank this frame can still make, even after the loop slept through several.
+	const double tempPeriods = std::ceil((tempNow + FramePacer::margin - FramePacer::lastSwap) / FramePacer::period);
+	FramePacer::targetVblank = FramePacer::lastSwap + std::max(1.0, tempPeriods) * FramePacer::period;
+	const double tempWake = FramePacer::targetVblank - FramePacer::margin;
+	while (tempNow < tempWake){
+		glfwWaitEventsTimeout(tempWake - tempNow);
+		tempNow = glfwGetTime();
+	}
+	FramePacer::workStart = tempNow;
+}
+
+void FramePacer::frame_built(const double& now_){
+	if (!FramePacer::enabled || FramePacer::workStart < 0.0) return;
+	const double tempWork = now_ - FramePacer::workStart;
+	const double tempDelta = tempWork - FramePacer::workMean;
+	FramePacer::workMean += workSmoothing * tempDelta;
+	FramePacer::workVariance = (1.0 - workSmoothing) * (FramePacer::workVariance + workSmoothing * tempDelta * tempDelta);
+	FramePacer::workStart = -1.0;
+}
+
+void FramePacer::frame_swapped(const double& now_){
+	if (!FramePacer::enabled) return;
+	if (FramePacer::targetVblank > 0.0){
+		FramePacer::framesPaced++;
+		if (now_ > FramePacer::targetVblank + 0.5 * FramePacer::period){
+			FramePacer::framesMissed++;
+			FramePacer::missPenalty += missStep;
+		}
+		else FramePacer::missPenalty *= 0.98;
+		// Only back-to-back swaps tell the refresh interval.
+		const double tempInterval = now_ - FramePacer::lastSwap;
+		if (tempInterval > 0.5 * FramePacer::period && tempInterval < 1.5 * FramePacer::period) FramePacer::period += periodSmoothing * (tempInterval - FramePacer::period);
+	}
+	FramePacer::lastSwap = now_;
+	FramePacer::targetVblank = -1.0;
+	FramePacer::update_margin();
+}
+
+void FramePacer::report(){
+	if (!FramePacer::enabled) return;
+	std::cout << std::fixed << std::setprecision(2) << "PACER: " << 1.0 / FramePacer::period << " Hz, margin " << FramePacer::margin * 1000.0
+		<< " ms (build " << FramePacer::workMean * 1000.0 << " ms avg), " << FramePacer::framesMissed << "/" << FramePacer::framesPaced << " frames missed their vblank\n";
+	std::cout.unsetf(std::ios_base::floatfield);
+}
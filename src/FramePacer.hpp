@@ -0,0 +1,49 @@
+#ifndef _FRAME_PACER_HPP_
+#define _FRAME_PACER_HPP_
+
+#include <cstdint>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+
+// Low latency pacing for the serial render path. Swaps are followed by glFinish, so the
+// swap returns at the vblank and its time gives the refresh phase; the period starts at
+// the monitor refresh rate and follows the measured swap intervals. wait() sleeps until
+// the next vblank minus a margin, then the loop polls input and builds the frame, so a
+// click is on screen at the first vblank after it. The margin is the mean build+submit
+// time plus three deviations, and grows whenever a frame misses its vblank.
+class FramePacer {
+private:
+	static bool enabled;
+	static double period;
+	static double lastSwap;
+	static double targetVblank;
+	static double workStart;
+	static double workMean;
+	static double workVariance;
+	static double missPenalty;
+	static double margin;
+	static uint64_t framesPaced;
+	static uint64_t framesMissed;
+
+	FramePacer(){}
+
+	static void update_margin();
+
+public:
+	static void init(GLFWwindow* window_, const bool& enabled_);
+	static const bool& is_enabled() { return FramePacer::enabled; }
+
+	// Before polling the input of a frame; handles events while it waits.
+	static void wait();
+	// Right before glfwSwapBuffers, and right after it (plus glFinish).
+	static void frame_built(const double& now_);
+	static void frame_swapped(const double& now_);
+
+	static void report();
+};
+
+
+
+#endif
@@ -5,21 +5,46 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "imgui.h"
+
+#include "Utilization.hpp"
+
 
 class GUISlot {
 private:
 	static bool inited;
 	static GLFWwindow* windowPtr;
+	static int framesPending;
+	static double lastFrameTime;
+	static InputStamps input;
+	static InputStamps frameInput;
 
 	GUISlot(){}
 
+	static void build(int& width_, int& height_);
+
 public:
 
 	static const bool& g_inited();
 
-	static void init(GLFWwindow* window_);
+	// Projector mode: a larger font, for a screen the whole table reads from.
+	// fastPath_ starts on the OpenGL3 streaming path, F2 flips it at run time.
+	static void init(GLFWwindow* window_, const bool& projector_ = false, const bool& fastPath_ = false);
 	static void destroy();
+	// Builds a frame, then renders it here or hands it to the RenderThread when one runs.
 	static void draw();
+	// GL half of a frame; runs on whichever thread owns the context.
+	static void render(ImDrawData* drawData_, const int& width_, const int& height_);
+
+	// Idle mode: frames are only built for a few iterations after input or a model change.
+	static void mark_dirty(const int& frames_ = 3);
+	static bool needs_frame(const double& now_);
+	static double g_wait_timeout();
+
+	// Input events also stamp their time, for the latency of the frame answering them.
+	static void input_received(const double& now_, const bool& click_ = false);
+	// Stamps of the input the last built frame answers.
+	static const InputStamps& g_frame_input() { return GUISlot::frameInput; }
 	
 };
 
@@ -0,0 +1,787 @@
+#include "GamePanels.hpp"
+
+#include <iostream>
+#include <string>
+#include <array>
+#include <list>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+
+#include "imgui.h"
+
+#include "rand.hpp"
+#include "StringPool.hpp"
+#include "Bestiary.hpp"
+#include "TextLayout.hpp"
+#include "CommandPalette.hpp"
+#include "Scenario.hpp"
+#include "ContestOdds.hpp"
+#include "Profiler.hpp"
+
+
+static ActorList allCreatures;
+static Bestiary bestiary;
+static std::string bestiaryPath;
+
+static std::vector<std::shared_ptr<ActorTemplate>> bestiaryTemplates;
+static uint64_t rosterRevision{0};
+static uint64_t panelsRevision{0};
+static const float columnWidth = 260.f;
+static const size_t paletteResults = 12;
+
+// Palette requests: the Game tab gets selected and scrolled to jumpTarget on the next frames.
+static bool paletteRequested{false};
+static std::weak_ptr<ActorSlot> jumpTarget;
+static bool selectGameTab{false};
+static bool scrollToTarget{false};
+
+void roster_changed(){
+	rosterRevision++;
+	panelsRevision++;
+}
+
+struct RosterView {
+	std::vector<std::shared_ptr<ActorSlot>> all;
+	std::vector<std::shared_ptr<ActorSlot>> players;
+	std::vector<std::shared_ptr<ActorSlot>> enemies;
+};
+
+// Random access copies of allCreatures, whole and split by faction, rebuilt only
+// after the roster changed.
+const RosterView& roster_view(){
+	static RosterView tempView;
+	static uint64_t tempRevision{~0ull};
+	if (tempRevision != rosterRevision){
+		tempView.all.assign(allCreatures.begin(), allCreatures.end());
+		tempView.players.clear();
+		tempView.enemies.clear();
+		for (const auto& Fi : allCreatures) (Fi->is_player() ? tempView.players : tempView.enemies).push_back(Fi);
+		tempRevision = rosterRevision;
+	}
+	return tempView;
+}
+
+void GamePanels::spawn_actors(const std::shared_ptr<ActorTemplate>& proto_, const bool& players_, const int& count_, const bool& asMob_, ActorList& out_){
+	if (count_ < 1) return;
+	const bool tempMob = asMob_ && count_ > 1;
+	out_.push_back(ActorSlot::create(proto_, players_, (count_ > 1 || tempMob) ? ++proto_->lastNumber : 0));
+	if (tempMob) { out_.back()->set_mob_size(static_cast<uint32_t>(count_)); return; }
+	for (int i = 1; i < count_; i++) out_.push_back(ActorSlot::create(proto_, players_, ++proto_->lastNumber));
+}
+
+// Spawns count_ instances sharing proto_, or a single mob of count_ creatures. They all
+// have the same initiative, so the insertion point is searched once for the whole group.
+void GamePanels::push_actors(const std::shared_ptr<ActorTemplate>& proto_, const bool& players_, const int& count_, const bool& asMob_){
+	ActorList tempGroup;
+	GamePanels::spawn_actors(proto_, players_, count_, asMob_, tempGroup);
+	if (tempGroup.empty()) return;
+	const std::shared_ptr<ActorSlot>& tempFirst = tempGroup.front();
+	auto tempPos = std::find_if(allCreatures.begin(), allCreatures.end(), [&](const std::shared_ptr<ActorSlot>& crea_){
+		return tempFirst->g_initiative() < crea_->g_initiative() || (tempFirst->g_initiative() <= crea_->g_initiative() && !crea_->is_player());
+	});
+	allCreatures.splice(tempPos, tempGroup);
+	roster_changed();
+}
+
+void GamePanels::set_roster(ActorList&& actors_){
+	allCreatures.clear();
+	allCreatures.splice(allCreatures.end(), actors_);
+	jumpTarget.reset();
+	roster_changed();
+}
+
+
+// Display strings of one actor, reformatted only when what they show changed. The name
+// and the mob count are per instance, they stay here; the bounded ones are interned.
+struct CreatureText {
+	uint64_t labelVersion{0};
+	int initiative{0};
+	uint32_t alive{0};
+	uint32_t mobSize{0};
+	std::array<int, 6> stats{};
+	bool valid{false};
+
+	std::array<char, 128> nameText{};
+	std::array<char, 32> aliveText{};
+	NameId initText{0};
+	std::array<NameId, 6> statTexts{};
+};
+
+static std::unordered_map<const ActorSlot*, CreatureText> creatureTexts;
+
+static NameId intern_format(const char* format_, ...){
+	char tempBuffer[128];
+	va_list tempArgs;
+	va_start(tempArgs, format_);
+	const int tempLength = std::vsnprintf(tempBuffer, sizeof(tempBuffer), format_, tempArgs);
+	va_end(tempArgs);
+	return StringPool::global().intern(tempBuffer, static_cast<size_t>(std::max(0, std::min(tempLength, static_cast<int>(sizeof(tempBuffer)) - 1))));
+}
+
+static const CreatureText& creature_text(const std::shared_ptr<ActorSlot>& crea_){
+	static uint64_t tempRevision{~0ull};
+	if (tempRevision != rosterRevision){
+		creatureTexts.clear();
+		tempRevision = rosterRevision;
+	}
+	CreatureText& tempText = creatureTexts[crea_.get()];
+	const uint32_t tempAlive = crea_->is_mob() ? crea_->g_mob_alive() : 0;
+	if (tempText.valid && tempText.labelVersion == crea_->g_label_version() && tempText.initiative == crea_->g_initiative() && tempText.alive == tempAlive
+		&& tempText.mobSize == crea_->g_mob_size() && tempText.stats == crea_->g_stats()) return tempText;
+
+	tempText.labelVersion = crea_->g_label_version();
+	tempText.initiative = crea_->g_initiative();
+	tempText.alive = tempAlive;
+	tempText.mobSize = crea_->g_mob_size();
+	tempText.stats = crea_->g_stats();
+	tempText.valid = true;
+	std::snprintf(tempText.nameText.data(), tempText.nameText.size(), "Name:%s", crea_->g_label());
+	std::snprintf(tempText.aliveText.data(), tempText.aliveText.size(), "Alive:%u/%u", tempText.alive, tempText.mobSize);
+	tempText.initText = intern_format("Init:%i", tempText.initiative);
+	for (size_t i = 0; i < tempText.statTexts.size(); i++) tempText.statTexts[i] = intern_format("%s:%i", statsNames.at(i).c_str(), tempText.stats[i]);
+	return tempText;
+}
+
+// One-line rows are never wrapped, the roster list clipper relies on a fixed row height.
+void print_creature(const std::shared_ptr<ActorSlot>& crea_, const bool& oneLine_){
+	const CreatureText& tempText = creature_text(crea_);
+	if (oneLine_) {
+		TextLayout::text(tempText.nameText.data());
+		ImGui::SameLine();
+		TextLayout::text(tempText.initText);
+		if (crea_->is_mob()) {
+			ImGui::SameLine();
+			TextLayout::text(tempText.aliveText.data());
+		}
+		for(size_t i = 0; i < tempText.statTexts.size(); i++){
+			ImGui::SameLine();
+			TextLayout::text(tempText.statTexts[i]);
+		}
+		return;
+	}
+
+	TextLayout::text_wrapped(tempText.nameText.data());
+	TextLayout::text_wrapped(tempText.initText);
+	if (crea_->is_mob()) TextLayout::text_wrapped(tempText.aliveText.data());
+
+	for(size_t i = 0; i < tempText.statTexts.size(); i++){
+		if(i%2 == 1) ImGui::SameLine();
+		TextLayout::text_wrapped(tempText.statTexts[i]);
+	}
+	
+}
+
+struct BodyBox {
+	ActorBodyPart part;
+	size_t box;
+	ImVec2 pos;
+};
+
+// Positions of every hit box inside the diagram, the same figure the old SmallButton grid drew.
+static const std::vector<BodyBox>& body_layout(){
+	static const std::vector<BodyBox> tempLayout = [](){
+		std::vector<BodyBox> tempBoxes;
+		for (size_t i = 0; i < 4; i++) tempBoxes.push_back({ActorBodyPart::Head, i, {45.f + 15.f*(i%2), 10.f + 15.f*(i/2)}});
+		for (size_t i = 0; i < 10; i++) tempBoxes.push_back({ActorBodyPart::Body, i, {30.f + 15.f*(i%4), 40.f + 15.f*(i/4)}});
+		for (size_t i = 0; i < 5; i++) tempBoxes.push_back({ActorBodyPart::Right_Hand, i, {10.f, 40.f + 15.f*i}});
+		for (size_t i = 0; i < 5; i++) tempBoxes.push_back({ActorBodyPart::Right_Leg, i, {95.f, 40.f + 15.f*i}});
+		for (size_t i = 0; i < 5; i++) tempBoxes.push_back({ActorBodyPart::Left_Hand, i, {35.f, 85.f + 15.f*i}});
+		for (size_t i = 0; i < 5; i++) tempBoxes.push_back({ActorBodyPart::Left_Leg, i, {70.f, 85.f + 15.f*i}});
+		return tempBoxes;
+	}();
+	return tempLayout;
+}
+
+static const float bodyBoxSize = 14.f;
+static const ImVec2 bodyDiagramSize{110.f, 160.f};
+
+// Hit boxes of one actor as a single item: one hit test on the whole area, then every
+// box goes straight into the window draw list. Clicking cycles a box empty -> / -> X.
+void print_hp(const std::shared_ptr<ActorSlot>& crea_, const bool& interactive_ = false){
+	PROFILE_SCOPE("print_hp");
+	const ImVec2 tempOrigin = ImGui::GetCursorScreenPos();
+	const auto& tempLayout = body_layout();
+	const BodyBox* tempHovered = nullptr;
+
+	if (interactive_) {
+		const bool tempClicked = ImGui::InvisibleButton("##Body", bodyDiagramSize);
+		if (ImGui::IsItemHovered()) {
+			const ImVec2 tempMouse{ImGui::GetIO().MousePos.x - tempOrigin.x, ImGui::GetIO().MousePos.y - tempOrigin.y};
+			for (const auto& Bi : tempLayout) {
+				if (tempMouse.x >= Bi.pos.x && tempMouse.x < Bi.pos.x + bodyBoxSize && tempMouse.y >= Bi.pos.y && tempMouse.y < Bi.pos.y + bodyBoxSize) { tempHovered = &Bi; break; }
+			}
+		}
+		if (tempClicked && tempHovered) {
+			crea_->set_hit_point(tempHovered->part, tempHovered->box, static_cast<char>((crea_->g_hit_point(tempHovered->part, tempHovered->box) + 1) % 3));
+			panelsRevision++;
+		}
+	}
+	else ImGui::Dummy(bodyDiagramSize);
+
+	ImDrawList* tempDrawList = ImGui::GetWindowDrawList();
+	const ImU32 tempColor = ImGui::GetColorU32(ImGuiCol_Button);
+	const ImU32 tempHoverColor = ImGui::GetColorU32(ImGui::IsMouseDown(ImGuiMouseButton_Left) ? ImGuiCol_ButtonActive : ImGuiCol_ButtonHovered);
+	const ImU32 tempTextColor = ImGui::GetColorU32(ImGuiCol_Text);
+	tempDrawList->PrimReserve(static_cast<int>(tempLayout.size()) * 6, static_cast<int>(tempLayout.size()) * 4);
+	for (const auto& Bi : tempLayout) {
+		const ImVec2 tempMin{tempOrigin.x + Bi.pos.x, tempOrigin.y + Bi.pos.y};
+		tempDrawList->PrimRect(tempMin, {tempMin.x + bodyBoxSize, tempMin.y + bodyBoxSize}, &Bi == tempHovered ? tempHoverColor : tempColor);
+	}
+
+	ImFont* tempFont = ImGui::GetFont();
+	const float tempFontSize = ImGui::GetFontSize();
+	for (const auto& Bi : tempLayout) {
+		const char tempState = crea_->g_hit_point(Bi.part, Bi.box);
+		if (tempState == 0) continue;
+		const ImWchar tempMark = tempState == 1 ? '/' : 'X';
+		const float tempAdvance = tempFont->GetCharAdvance(tempMark) * tempFontSize / tempFont->FontSize;
+		tempFont->RenderChar(tempDrawList, tempFontSize, {tempOrigin.x + Bi.pos.x + (bodyBoxSize - tempAdvance) * 0.5f, tempOrigin.y + Bi.pos.y + (bodyBoxSize - tempFontSize) * 0.5f}, tempTextColor, tempMark);
+	}
+}
+
+void print_mob_wounds(const std::shared_ptr<ActorSlot>& crea_){
+	ImGui::Text("Wounds:%u (%u per creature)", crea_->g_mob_wounds(), crea_->g_mob_toughness());
+	ImGui::SameLine();
+	if (ImGui::SmallButton("-")) crea_->add_mob_wounds(-1);
+	ImGui::SameLine();
+	if (ImGui::SmallButton("+")) crea_->add_mob_wounds(1);
+	ImGui::SameLine();
+	if (ImGui::SmallButton("Kill one")) crea_->add_mob_wounds(static_cast<int>(crea_->g_mob_toughness() - crea_->g_mob_wounds() % crea_->g_mob_toughness()));
+}
+
+void print_tooltip(const std::shared_ptr<ActorSlot>& crea_){
+	ImGui::BeginTooltip();
+	if (crea_->is_mob()) ImGui::Text("Wounds:%u, alive:%u/%u", crea_->g_mob_wounds(), crea_->g_mob_alive(), crea_->g_mob_size());
+	else print_hp(crea_);
+	//TODO
+	ImGui::EndTooltip();
+
+}
+
+// Odds of crea_ rolling against target_, both with their whole pools.
+void print_contest_tooltip(const std::shared_ptr<ActorSlot>& crea_, const std::shared_ptr<ActorSlot>& target_){
+	const int tempPool = crea_->g_pool_size();
+	const int tempTargetPool = target_->g_pool_size();
+	const ContestResult& tempOdds = ContestOdds::g_odds(tempPool, tempTargetPool);
+	ImGui::BeginTooltip();
+	ImGui::Text("%s (%id) vs %s (%id)", crea_->g_label(), tempPool, target_->g_label(), tempTargetPool);
+	ImGui::Text("Win %.1f%%  Tie %.1f%%  Lose %.1f%%", tempOdds.win * 100.0, tempOdds.tie * 100.0, tempOdds.lose * 100.0);
+	ImGui::TextDisabled("Any set: %.1f%% / %.1f%%", ContestOdds::g_set_chance(tempPool) * 100.0, ContestOdds::g_set_chance(tempTargetPool) * 100.0);
+	ImGui::EndTooltip();
+}
+
+void print_memory_report(){
+	ImGui::BeginTooltip();
+	for (const auto& Pi : SlabPool::g_all()){
+		const SlabPool::Usage tempUsage = Pi->g_usage();
+		ImGui::Text("%s: %u/%u blocks of %u B, peak %u, %.1f KiB reserved", tempUsage.name, static_cast<unsigned>(tempUsage.inUse),
+			static_cast<unsigned>(tempUsage.reserved / tempUsage.blockSize), static_cast<unsigned>(tempUsage.blockSize), static_cast<unsigned>(tempUsage.peak), tempUsage.reserved / 1024.f);
+	}
+	ImGui::EndTooltip();
+}
+
+void bestiary_picker(const bool& players_, const int& count_, const bool& asMob_, const char* name_, const std::array<int, 6>& stats_, const int& addInitiative_){
+	static char tempQuery[40];
+	static std::vector<uint32_t> tempResults;
+	if (!ImGui::BeginPopup("BestiaryPicker")) return;
+
+	if (ImGui::IsWindowAppearing()) ImGui::SetKeyboardFocusHere();
+	ImGui::InputText("Search", tempQuery, IM_ARRAYSIZE(tempQuery));
+	bestiary.search(tempQuery, 20, tempResults);
+	ImGui::SameLine();
+	if (ImGui::Button("Add current") && name_[0] != '\0') bestiary.add(name_, stats_, addInitiative_);
+	ImGui::Text("%i templates", static_cast<int>(bestiary.size()));
+	ImGui::Separator();
+
+	for (const auto& Ri : tempResults){
+		const BestiaryEntry tempEntry = bestiary.g_entry(Ri);
+		ImGui::PushID(static_cast<int>(Ri));
+		if (ImGui::Selectable(tempEntry.name)){
+			if (bestiaryTemplates.size() < bestiary.size()) bestiaryTemplates.resize(bestiary.size());
+			if (!bestiaryTemplates.at(Ri)) bestiaryTemplates.at(Ri) = ActorTemplate::create(StringPool::global().intern(tempEntry.name, tempEntry.nameLength), tempEntry.stats, tempEntry.addInitiative);
+			GamePanels::push_actors(bestiaryTemplates.at(Ri), players_, count_, asMob_);
+		}
+		if (ImGui::IsItemHovered()){
+			ImGui::BeginTooltip();
+			for (size_t i = 0; i < tempEntry.stats.size(); i++){
+				if (i%2 == 1) ImGui::SameLine();
+				ImGui::Text("%s:%i", statsNames.at(i).c_str(), tempEntry.stats.at(i));
+			}
+			ImGui::EndTooltip();
+		}
+		ImGui::PopID();
+	}
+	ImGui::EndPopup();
+}
+
+// Replaces the roster with a seeded synthetic encounter, see Scenario.
+void scenario_picker(){
+	static ScenarioSpec tempSpec{10, 90, 1, true};
+	if (!ImGui::BeginPopup("ScenarioPicker")) return;
+
+	if (ImGui::InputInt("Players", &tempSpec.players, 10, 100)) tempSpec.players = std::max(0, std::min(tempSpec.players, 10000));
+	if (ImGui::InputInt("Enemies", &tempSpec.enemies, 10, 100)) tempSpec.enemies = std::max(0, std::min(tempSpec.enemies, 10000));
+	int tempSeed = static_cast<int>(tempSpec.seed);
+	if (ImGui::InputInt("Seed", &tempSeed)) tempSpec.seed = static_cast<uint32_t>(std::max(0, tempSeed));
+	ImGui::Checkbox("Actions, targets and rolls", &tempSpec.prefill);
+	for (const int& Ni : {100, 1000, 10000}){
+		ImGui::PushID(Ni);
+		if (ImGui::SmallButton(std::to_string(Ni).c_str())) { tempSpec.players = Ni / 10; tempSpec.enemies = Ni - Ni / 10; }
+		ImGui::PopID();
+		ImGui::SameLine();
+	}
+	ImGui::NewLine();
+	ImGui::Separator();
+	if (ImGui::Button("Generate (replaces the roster)")){
+		Scenario::generate(tempSpec);
+		ImGui::CloseCurrentPopup();
+	}
+	ImGui::EndPopup();
+}
+
+// Stats of one instance. The first edit gives it its own copy of the template, the rest
+// of its group keeps the shared one.
+void instance_editor(const std::shared_ptr<ActorSlot>& crea_){
+	if (!ImGui::BeginPopup("InstanceEditor")) return;
+	if (!crea_) { ImGui::CloseCurrentPopup(); ImGui::EndPopup(); return; }
+
+	ImGui::Text("%s", crea_->g_label());
+	ImGui::SameLine();
+	ImGui::TextDisabled(crea_->g_template().use_count() > 1 ? "(shared template)" : "(own template)");
+	std::array<int, 6> tempStats = crea_->g_stats();
+	bool tempChanged = false;
+	for (size_t i = 0; i < tempStats.size(); i++){
+		if (ImGui::InputInt(statsNames.at(i).c_str(), &tempStats[i])) { tempStats[i] = std::max(0, std::min(tempStats[i], 10)); tempChanged = true; }
+	}
+	if (tempChanged){
+		crea_->edit_template().stats = tempStats;
+		crea_->template_changed();
+		panelsRevision++;
+	}
+	ImGui::EndPopup();
+}
+
+void GamePanels::manage_creatures(const bool& players_){
+	PROFILE_SCOPE("manage_creatures");
+
+	static bool cleanAfterPush{true};
+	static char tempName[40];
+	static int tempInitiative{0};
+	static int tempCount{1};
+	static bool tempAsMob{false};
+	static std::array<int, static_cast<size_t>(ActorStat::END_OF_LIST)> tempStats{0,0,0,0,0,0};
+	ImGuiInputTextFlags inputFlags = 0;
+	inputFlags |= ImGuiInputTextFlags_CharsDecimal;
+	inputFlags |= ImGuiInputTextFlags_CharsNoBlank;
+
+    ImGui::InputText("Name", tempName, IM_ARRAYSIZE(tempName));
+	ImGui::SameLine();
+	ImGui::Checkbox("Clean after push", &cleanAfterPush);
+
+	ImGui::InputInt("Additional Initiative", &tempInitiative);
+	if (ImGui::InputInt("Count", &tempCount)) tempCount = std::max(1, std::min(tempCount, 1000));
+	ImGui::SameLine();
+	ImGui::Checkbox("As mob", &tempAsMob);
+
+	ImGui::Separator();
+	for (int i = 0; i < 6; i++) ImGui::InputInt(statsNames.at(i).c_str(), &tempStats[i]);
+	
+	ImGui::Separator();
+	if (ImGui::Button("Randomize Stats")){
+		for(int i = 0; i < 6; i++) tempStats[i] = Scenario::stat_from_d10(rand_int(1,10));
+	}
+
+	ImGui::SameLine();
+	if (ImGui::Button("Push Actor")) {
+		if (tempName[0] != '\0'){
+			push_actors(ActorTemplate::create(tempName, tempStats, tempInitiative), players_, tempCount, tempAsMob);
+			if(cleanAfterPush){
+				memset(tempName, 0, IM_ARRAYSIZE(tempName));
+				tempInitiative = 0;
+				tempStats = {0,0,0,0,0,0};
+				tempCount = 1;
+			}
+		}
+	}
+
+	ImGui::SameLine();
+	if (ImGui::Button("Bestiary")) ImGui::OpenPopup("BestiaryPicker");
+	ImGui::SameLine();
+	if (ImGui::Button("Scenario")) ImGui::OpenPopup("ScenarioPicker");
+	ImGui::SameLine();
+	ImGui::TextDisabled("(mem)");
+	if (ImGui::IsItemHovered()) print_memory_report();
+	bestiary_picker(players_, tempCount, tempAsMob, tempName, tempStats, tempInitiative);
+	scenario_picker();
+
+	if (ImGui::BeginChild("List", ImVec2(0.f, 0.f), true, 0)){
+		const auto& tempRows = players_ ? roster_view().players : roster_view().enemies;
+		static std::weak_ptr<ActorSlot> tempEdited;
+		std::shared_ptr<ActorSlot> tempRemoved;
+		bool tempEditRequested = false;
+		ImGuiListClipper tempClipper;
+		tempClipper.Begin(static_cast<int>(tempRows.size()));
+		while (tempClipper.Step()) {
+			for (int id = tempClipper.DisplayStart; id < tempClipper.DisplayEnd; id++) {
+				const auto& Fi = tempRows[id];
+				ImGui::PushID(id);
+				if (ImGui::Button("-")) tempRemoved = Fi;
+				ImGui::SameLine();
+				if (ImGui::Button("Edit")) { tempEdited = Fi; tempEditRequested = true; }
+				ImGui::SameLine();
+				ImGui::BeginGroup();
+				print_creature(Fi, true);
+				ImGui::EndGroup();
+				if(ImGui::IsItemHovered()){
+					print_tooltip(Fi);
+				}
+				ImGui::PopID();
+			}
+		}
+		if (tempEditRequested) ImGui::OpenPopup("InstanceEditor");
+		instance_editor(tempEdited.lock());
+		if (tempRemoved) {
+			allCreatures.remove(tempRemoved);
+			roster_changed();
+		}
+		ImGui::EndChild();
+	}
+}
+
+
+void run_command(const PaletteCommand& command_);
+
+void jump_to(const std::shared_ptr<ActorSlot>& crea_){
+	jumpTarget = crea_;
+	selectGameTab = true;
+	scrollToTarget = true;
+	panelsRevision++;
+}
+
+// Next actor after the last jump target, in roster order, with action_ in one of its slots.
+void jump_to_action(const ActorAction& action_){
+	const auto& tempColumns = roster_view().all;
+	if (tempColumns.empty()) return;
+	const auto tempTarget = jumpTarget.lock();
+	const auto tempCurrent = std::find(tempColumns.begin(), tempColumns.end(), tempTarget);
+	const size_t tempStart = tempCurrent == tempColumns.end() ? tempColumns.size() - 1 : static_cast<size_t>(tempCurrent - tempColumns.begin());
+	for (size_t i = 1; i <= tempColumns.size(); i++){
+		const auto& Ci = tempColumns[(tempStart + i) % tempColumns.size()];
+		for (const auto& Ai : Ci->g_actions()){
+			if (std::get<0>(Ai) != action_) continue;
+			jump_to(Ci);
+			return;
+		}
+	}
+}
+
+void accept_palette_entry(const PaletteEntry& entry_){
+	switch (entry_.kind){
+	case PaletteKind::Actor: if (const auto tempActor = entry_.actor.lock()) jump_to(tempActor); break;
+	case PaletteKind::Action: jump_to_action(entry_.action); break;
+	case PaletteKind::Command: run_command(entry_.command); break;
+	}
+}
+
+// Ctrl+K: type to search actors, actions and commands, arrows pick, Enter jumps or runs.
+// The index is only searched again when the query or the roster changed.
+void command_palette(){
+	static char tempQuery[64];
+	static char tempSearched[64];
+	static uint64_t tempSearchedRevision{~0ull};
+	static std::vector<uint32_t> tempResults;
+	static int tempSelected{0};
+	if (paletteRequested){
+		paletteRequested = false;
+		tempQuery[0] = '\0';
+		tempSelected = 0;
+		tempSearchedRevision = ~0ull;
+		CommandPalette::invalidate();
+		ImGui::OpenPopup("CommandPalette");
+	}
+	const ImVec2 tempDisplay = ImGui::GetIO().DisplaySize;
+	ImGui::SetNextWindowPos({tempDisplay.x * 0.5f, tempDisplay.y * 0.15f}, ImGuiCond_Always, {0.5f, 0.f});
+	ImGui::SetNextWindowSize({420.f, 0.f});
+	if (!ImGui::BeginPopup("CommandPalette")) return;
+	PROFILE_SCOPE("command_palette");
+
+	CommandPalette::sync(allCreatures, rosterRevision);
+	if (ImGui::IsWindowAppearing()) ImGui::SetKeyboardFocusHere();
+	ImGui::SetNextItemWidth(-1.f);
+	const bool tempEnter = ImGui::InputText("##Query", tempQuery, IM_ARRAYSIZE(tempQuery), ImGuiInputTextFlags_EnterReturnsTrue);
+	if (std::strcmp(tempQuery, tempSearched) != 0 || tempSearchedRevision != rosterRevision){
+		PROFILE_SCOPE("CommandPalette::search");
+		CommandPalette::search(tempQuery, paletteResults, tempResults);
+		std::memcpy(tempSearched, tempQuery, sizeof(tempSearched));
+		tempSearchedRevision = rosterRevision;
+		tempSelected = 0;
+	}
+
+	const int tempCount = static_cast<int>(tempResults.size());
+	if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_DownArrow))) tempSelected = std::min(tempSelected + 1, std::max(0, tempCount - 1));
+	if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_UpArrow))) tempSelected = std::max(tempSelected - 1, 0);
+	int tempAccepted = tempEnter && tempCount > 0 ? tempSelected : -1;
+	for (int i = 0; i < tempCount; i++){
+		const PaletteEntry& tempEntry = CommandPalette::g_entry(tempResults[static_cast<size_t>(i)]);
+		ImGui::PushID(i);
+		if (ImGui::Selectable(tempEntry.g_label(), i == tempSelected)) tempAccepted = i;
+		ImGui::SameLine(320.f);
+		if (tempEntry.kind == PaletteKind::Actor){
+			const auto tempActor = tempEntry.actor.lock();
+			ImGui::TextDisabled(tempActor && tempActor->is_player() ? "player" : "enemy");
+		}
+		else ImGui::TextDisabled(tempEntry.kind == PaletteKind::Action ? "action" : "command");
+		ImGui::PopID();
+	}
+	if (tempCount == 0 && tempQuery[0] != '\0') ImGui::TextDisabled("No matches");
+
+	if (tempAccepted >= 0){
+		accept_palette_entry(CommandPalette::g_entry(tempResults[static_cast<size_t>(tempAccepted)]));
+		ImGui::CloseCurrentPopup();
+	}
+	else if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_Escape))) ImGui::CloseCurrentPopup();
+	ImGui::EndPopup();
+}
+
+
+void game_column(const std::shared_ptr<ActorSlot>& crea_){
+	ImGui::PushID(crea_.get());
+	ImGui::BeginGroup();
+	print_creature(crea_, false);
+	int notFirst2{0};
+	ImGui::Text("---------------------------");
+	ImGui::TextWrapped("Actions:");
+	for (auto& Ai : crea_->g_actions()) {
+		ImGui::PushID(notFirst2);
+		if (notFirst2%2 == 1) ImGui::SameLine();
+		else ImGui::Text("---------------------------");
+		ImGui::BeginGroup();
+
+		ImGui::SetNextItemWidth(100.f);
+		if (ImGui::BeginCombo("##Actions", ActionsData::g_data(std::get<0>(Ai)).g_name().c_str(), ImGuiComboFlags_NoArrowButton)) {
+    		for (ActorAction i = static_cast<ActorAction>(0); i < ActorAction::END_OF_LIST; i++) {
+       			const bool is_selected = (std::get<0>(Ai) == i);
+        		if (ImGui::Selectable(ActionsData::g_data(i).g_name().c_str(), is_selected)) {
+					crea_->set_action(static_cast<size_t>(notFirst2), i);
+				} 
+        		if (is_selected) ImGui::SetItemDefaultFocus();
+    		}
+    		ImGui::EndCombo();
+		}
+
+		ImGui::SetNextItemWidth(100.f);
+		const bool tempTargetsOpen = ImGui::BeginCombo("##Targets", (std::get<1>(Ai) ? std::get<1>(Ai)->g_label() : "---"), ImGuiComboFlags_NoArrowButton);
+		if (!tempTargetsOpen && std::get<1>(Ai) && ImGui::IsItemHovered()) print_contest_tooltip(crea_, std::get<1>(Ai));
+		if (tempTargetsOpen) {
+    		if (std::get<0>(Ai) > ActorAction::None && std::get<0>(Ai) < ActorAction::END_OF_LIST) for (auto& i : allCreatures) {
+				if(!i) continue;
+				if (i->is_mob() && i->g_mob_alive() == 0) continue;
+       			const bool is_selected = (std::get<1>(Ai) == i);
+        		if (ImGui::Selectable(i->g_label(), is_selected)) {
+					std::get<1>(Ai) = i;
+					
+				} 
+				if (ImGui::IsItemHovered()) print_contest_tooltip(crea_, i);
+        		if (is_selected) ImGui::SetItemDefaultFocus();
+    		}
+    		ImGui::EndCombo();
+		}
+
+		ImGui::SetNextItemWidth(100.f);
+		const char* tempLableForDice = (std::get<2>(Ai) < crea_->g_rolls().size() ? dice_label(crea_->g_rolls().at(std::get<2>(Ai)).first, crea_->g_rolls().at(std::get<2>(Ai)).second) : "---");
+		if (ImGui::BeginCombo("##Dice", tempLableForDice, ImGuiComboFlags_NoArrowButton)) {
+			bool is_selected = false;
+			if (std::get<0>(Ai) > ActorAction::None && std::get<0>(Ai) < ActorAction::END_OF_LIST) for (size_t i = 0; i < crea_->g_rolls().size(); i++) {
+				if (crea_->g_rolls().at(i).second < 2) continue; 
+				if (crea_->is_roll_claimed(i)) continue;
+				is_selected = (std::get<2>(Ai) == i);
+        		if (ImGui::Selectable(dice_label(crea_->g_rolls().at(i).first, crea_->g_rolls().at(i).second), is_selected)) {
+					crea_->set_action_roll(static_cast<size_t>(notFirst2), i);
+				} 
+        		if (is_selected) ImGui::SetItemDefaultFocus();
+			}
+			is_selected = (std::get<2>(Ai) > 10);
+			if (ImGui::Selectable("---", is_selected)){
+				crea_->set_action_roll(static_cast<size_t>(notFirst2), 100);
+			}
+			if (is_selected) ImGui::SetItemDefaultFocus();
+    		ImGui::EndCombo();
+		}
+		ImGui::EndGroup();
+		notFirst2++;
+		ImGui::PopID();
+	}
+	{
+		int tempI = 1;
+		ImGui::Text("---------------------------");
+		ImGui::Text("Amount of dice: %i +", crea_->g_number_of_dice());
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(30.f);
+		ImGui::DragInt("##Drag", &crea_->g_add_roll(), 1, -10, 10, "%i");
+		if (crea_->is_mob()) {
+			ImGui::SameLine();
+			ImGui::Text("+ %i mob", crea_->g_mob_bonus_dice());
+		}
+		ImGui::Text("Rolls:");
+		ImGui::BeginGroup();
+		for (const auto& Ri : crea_->g_rolls()){
+			if (tempI%3 != 0) ImGui::SameLine();
+			ImGui::TextWrapped(" %i:%i,", Ri.first, Ri.second);
+			tempI++;
+		}
+		ImGui::EndGroup();
+		if (crea_->is_mob() && crea_->g_rolled()) ImGui::Text("Acting: %u of %u alive", crea_->g_mob_acting(), crea_->g_mob_alive());
+	}
+	ImGui::Text("---------------------------");
+	if (ImGui::Button("Clear")) crea_->new_turn();
+	ImGui::SameLine();
+	if (ImGui::Button("Roll")) crea_->roll();
+	ImGui::SameLine();
+	if (crea_->is_mob()) { ImGui::NewLine(); print_mob_wounds(crea_); }
+	else if (ImGui::Button(CommandPalette::g_command_name(PaletteCommand::Show_Body))) crea_->set_show_body(!crea_->g_show_body());
+
+	if (crea_->g_show_body() && !crea_->is_mob()) {
+		print_hp(crea_, true);
+	}
+
+	
+	ImGui::EndGroup();
+	ImGui::PopID();
+}
+
+
+void GamePanels::game_menu(){
+	PROFILE_SCOPE("game_menu");
+	const auto& tempColumns = roster_view().all;
+	ImGui::SetNextWindowContentSize({tempColumns.size() * columnWidth, 700.f});
+	if(ImGui::BeginChild("AllActors", ImVec2(0.f, ImGui::GetWindowSize().y/1.2f), true, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_AlwaysHorizontalScrollbar)){
+		// Only the columns inside the scrolled view are built, the content size above
+		// stands in for the rest.
+		// GetCursorStartPos() has the scroll taken off and SetCursorPos() takes it off again,
+		// so the origin is put back in unscrolled content coordinates.
+		const float tempScroll = ImGui::GetScrollX();
+		const ImVec2 tempOrigin = {ImGui::GetCursorStartPos().x + tempScroll, ImGui::GetCursorStartPos().y + ImGui::GetScrollY()};
+		const size_t tempFirst = static_cast<size_t>(std::max(0.f, (tempScroll - tempOrigin.x) / columnWidth));
+		const size_t tempLast = std::min(tempColumns.size(), static_cast<size_t>((tempScroll + ImGui::GetWindowWidth()) / columnWidth) + 1);
+		if (scrollToTarget){
+			const auto tempTarget = std::find(tempColumns.begin(), tempColumns.end(), jumpTarget.lock());
+			if (tempTarget != tempColumns.end()) ImGui::SetScrollX(static_cast<float>(tempTarget - tempColumns.begin()) * columnWidth);
+			scrollToTarget = false;
+			// The scroll is applied when the child begins next frame.
+			panelsRevision++;
+		}
+		const auto tempJumped = jumpTarget.lock();
+		const float tempSpacing = ImGui::GetStyle().ItemSpacing.x;
+		const ImVec2 tempWindowPos = ImGui::GetWindowPos();
+		const ImVec2 tempWindowSize = ImGui::GetWindowSize();
+		ImDrawList* tempDrawList = ImGui::GetWindowDrawList();
+		for (size_t i = tempFirst; i < tempLast; i++){
+			const float tempX = tempOrigin.x + i * columnWidth;
+			ImGui::SetCursorPos({tempX, tempOrigin.y});
+			const ImVec2 tempScreen = ImGui::GetCursorScreenPos();
+			if (i > 0) tempDrawList->AddLine({tempScreen.x - tempSpacing, tempWindowPos.y}, {tempScreen.x - tempSpacing, tempWindowPos.y + tempWindowSize.y}, ImGui::GetColorU32(ImGuiCol_Border));
+			// Outline the actor the palette last jumped to.
+			if (tempColumns[i] == tempJumped) tempDrawList->AddRect({tempScreen.x - 2.f, tempScreen.y - 2.f}, {tempScreen.x + columnWidth - 1.5f * tempSpacing, tempWindowPos.y + tempWindowSize.y - ImGui::GetStyle().ScrollbarSize - 2.f}, ImGui::GetColorU32(ImGuiCol_NavHighlight));
+			ImGui::PushClipRect(tempScreen, {tempScreen.x + columnWidth - 2.f * tempSpacing, tempWindowPos.y + tempWindowSize.y}, true);
+			ImGui::PushTextWrapPos(tempX + columnWidth - 2.f * tempSpacing);
+			game_column(tempColumns[i]);
+			ImGui::PopTextWrapPos();
+			ImGui::PopClipRect();
+		}
+		ImGui::EndChild();
+	}
+
+	for (PaletteCommand Ci : {PaletteCommand::Roll_All, PaletteCommand::Roll_Enemies, PaletteCommand::Roll_Players, PaletteCommand::Next_Turn}){
+		if (Ci != PaletteCommand::Roll_All) ImGui::SameLine();
+		if (ImGui::Button(CommandPalette::g_command_name(Ci))) run_command(Ci);
+	}
+
+}
+
+// Game tab buttons, also run from the palette. Show Body acts on the last actor jumped to.
+void run_command(const PaletteCommand& command_){
+	switch (command_){
+	case PaletteCommand::Roll_All:
+		for(const auto& Fi : allCreatures){ if(!Fi->g_rolled()) Fi->roll(); }
+		break;
+	case PaletteCommand::Roll_Enemies:
+		for(const auto& Fi : allCreatures){ if (!Fi->is_player()) if (!Fi->g_rolled()) Fi->roll(); }
+		break;
+	case PaletteCommand::Roll_Players:
+		for(const auto& Fi : allCreatures){ if (Fi->is_player()) if (!Fi->g_rolled()) Fi->roll(); }
+		break;
+	case PaletteCommand::Next_Turn:
+		for(const auto& Fi : allCreatures) Fi->new_turn();
+		break;
+	case PaletteCommand::Show_Body:
+		if (const auto tempTarget = jumpTarget.lock()){
+			if (!tempTarget->is_mob()) tempTarget->set_show_body(!tempTarget->g_show_body());
+			jump_to(tempTarget);
+		}
+		break;
+	default: break;
+	}
+	panelsRevision++;
+}
+
+
+void GamePanels::init(const char* bestiaryPath_){
+	ActionsData::init();
+	if (bestiaryPath_ == nullptr) return;
+	bestiaryPath = bestiaryPath_;
+	bestiary.open(bestiaryPath);
+}
+
+void GamePanels::destroy(){
+	if (!bestiaryPath.empty() && !bestiary.save()) std::cout << "BESTIARY: failed to save " << bestiaryPath << "\n";
+}
+
+void GamePanels::draw(const float& width_, const float& height_){
+	ImGuiWindowFlags window_flags = 0;
+	window_flags |= ImGuiWindowFlags_NoTitleBar;
+	window_flags |= ImGuiWindowFlags_NoScrollbar;
+	window_flags |= ImGuiWindowFlags_NoMove;
+	window_flags |= ImGuiWindowFlags_NoResize;
+	window_flags |= ImGuiWindowFlags_NoCollapse;
+	ImGui::Begin("Main", nullptr, window_flags);
+	ImGui::SetWindowSize({width_, height_});
+	ImGui::SetWindowPos({0.f, 0.f});
+
+	if (ImGui::BeginTabBar("All", 0)) {
+		if (ImGui::BeginTabItem("Manage Enemies")) {
+			GamePanels::manage_creatures(false);
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Manage Players")) {
+			GamePanels::manage_creatures(true);
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Game", nullptr, selectGameTab ? ImGuiTabItemFlags_SetSelected : 0)){
+			GamePanels::game_menu();
+			ImGui::EndTabItem();
+		}
+		selectGameTab = false;
+		ImGui::EndTabBar();
+	}
+	command_palette();
+
+	ImGui::End();
+}
+
+ActorList& GamePanels::g_creatures() { return allCreatures; }
+
+void GamePanels::clear(){
+	allCreatures.clear();
+	jumpTarget.reset();
+	roster_changed();
+}
+
+void GamePanels::open_palette() { paletteRequested = true; }
+
+const uint64_t& GamePanels::g_revision() { return panelsRevision; }
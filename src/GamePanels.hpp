@@ -0,0 +1,45 @@
+#ifndef _GAME_PANELS_HPP_
+#define _GAME_PANELS_HPP_
+
+
+#include <cstdint>
+#include <memory>
+
+#include "ActorSlot.hpp"
+
+
+// The roster and every panel drawn in the main window. Depends only on an ImGui context,
+// so it runs the same under the GLFW/OpenGL3 backends and in the headless benchmarks.
+class GamePanels {
+private:
+	GamePanels(){}
+
+public:
+
+	// bestiaryPath_ may be nullptr to run without a bestiary file.
+	static void init(const char* bestiaryPath_);
+	static void destroy();
+
+	// Main window with the three tabs, covering width_ x height_ from the origin.
+	static void draw(const float& width_, const float& height_);
+	static void manage_creatures(const bool& players_);
+	static void game_menu();
+
+	static ActorList& g_creatures();
+	static void push_actors(const std::shared_ptr<ActorTemplate>& proto_, const bool& players_, const int& count_, const bool& asMob_);
+	// The slots push_actors would add, numbered the same way, appended to out_ and not to the roster.
+	static void spawn_actors(const std::shared_ptr<ActorTemplate>& proto_, const bool& players_, const int& count_, const bool& asMob_, ActorList& out_);
+	// Replaces the roster with actors_, already in turn order, in one go.
+	static void set_roster(ActorList&& actors_);
+	static void clear();
+	// Ctrl+K command palette, opened on the next draw().
+	static void open_palette();
+
+	// Bumped whenever a panel changes the model, the frontend redraws a few more frames.
+	static const uint64_t& g_revision();
+
+};
+
+
+
+#endif
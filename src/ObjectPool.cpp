@@ -0,0 +1,85 @@
+#include "ObjectPool.hpp"
+
+#include <algorithm>
+
+
+static std::vector<SlabPool*>& pool_registry(){
+	static std::vector<SlabPool*> registry;
+	return registry;
+}
+
+static size_t align_up(const size_t& value_, const size_t& alignment_){
+	return (value_ + alignment_ - 1) / alignment_ * alignment_;
+}
+
+
+// Cuts the pooled type out of a __PRETTY_FUNCTION__ / __FUNCSIG__ string.
+static std::string short_type_name(const char* name_){
+	const std::string tempName{name_};
+	size_t tempBegin = tempName.find("T = ");
+	if (tempBegin != std::string::npos){
+		tempBegin += 4;
+		return tempName.substr(tempBegin, tempName.find_first_of(";]", tempBegin) - tempBegin);
+	}
+	tempBegin = tempName.find("PoolAllocator<");
+	if (tempBegin != std::string::npos){
+		tempBegin += 14;
+		return tempName.substr(tempBegin, tempName.rfind(">::") - tempBegin);
+	}
+	return tempName;
+}
+
+
+SlabPool::SlabPool(const char* name_, const size_t& blockSize_, const size_t& alignment_, const size_t& blocksPerSlab_)
+	: name{ short_type_name(name_) }, blocksPerSlab{ std::max<size_t>(1, blocksPerSlab_) }{
+	// Slabs come from new char[], which is aligned for any fundamental type.
+	this->blockSize = align_up(std::max(blockSize_, sizeof(FreeNode)), std::max(alignment_, alignof(FreeNode)));
+	pool_registry().push_back(this);
+}
+
+SlabPool::~SlabPool(){
+	auto& tempRegistry = pool_registry();
+	tempRegistry.erase(std::remove(tempRegistry.begin(), tempRegistry.end(), this), tempRegistry.end());
+}
+
+void SlabPool::add_slab(){
+	this->slabs.emplace_back(new char[this->blockSize * this->blocksPerSlab]);
+	char* tempSlab = this->slabs.back().get();
+	for (size_t i = this->blocksPerSlab; i > 0; i--){
+		FreeNode* tempNode = reinterpret_cast<FreeNode*>(tempSlab + (i - 1) * this->blockSize);
+		tempNode->next = this->freeList;
+		this->freeList = tempNode;
+	}
+}
+
+void* SlabPool::allocate(){
+	if (this->freeList == nullptr) this->add_slab();
+	FreeNode* tempNode = this->freeList;
+	this->freeList = tempNode->next;
+	this->inUse++;
+	this->peak = std::max(this->peak, this->inUse);
+	return tempNode;
+}
+
+void SlabPool::deallocate(void* block_){
+	if (block_ == nullptr) return;
+	FreeNode* tempNode = static_cast<FreeNode*>(block_);
+	tempNode->next = this->freeList;
+	this->freeList = tempNode;
+	this->inUse--;
+}
+
+SlabPool::Usage SlabPool::g_usage() const {
+	Usage tempUsage;
+	tempUsage.name = this->name.c_str();
+	tempUsage.blockSize = this->blockSize;
+	tempUsage.slabs = this->slabs.size();
+	tempUsage.reserved = this->slabs.size() * this->blocksPerSlab * this->blockSize;
+	tempUsage.inUse = this->inUse;
+	tempUsage.peak = this->peak;
+	return tempUsage;
+}
+
+const std::vector<SlabPool*>& SlabPool::g_all(){
+	return pool_registry();
+}
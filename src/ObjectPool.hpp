@@ -0,0 +1,133 @@
+#ifndef _OBJECT_POOL_HPP_
+#define _OBJECT_POOL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <vector>
+#include <array>
+#include <stdexcept>
+#include <string>
+
+
+// Fixed-size block allocator. Blocks are carved out of slabs that are never returned
+// to the heap; freed blocks go to an intrusive free list and are handed out first.
+// Not thread safe, all pools are used from the UI thread.
+class SlabPool {
+private:
+	struct FreeNode { FreeNode* next; };
+
+	std::string name;
+	size_t blockSize;
+	size_t blocksPerSlab;
+	std::vector<std::unique_ptr<char[]>> slabs;
+	FreeNode* freeList{nullptr};
+	size_t inUse{0};
+	size_t peak{0};
+
+	void add_slab();
+
+public:
+	struct Usage {
+		const char* name;
+		size_t blockSize;
+		size_t slabs;
+		size_t reserved;		// bytes
+		size_t inUse;			// blocks
+		size_t peak;			// blocks
+	};
+
+	SlabPool(const char* name_, const size_t& blockSize_, const size_t& alignment_, const size_t& blocksPerSlab_ = 256);
+	SlabPool(const SlabPool&) = delete;
+	SlabPool& operator=(const SlabPool&) = delete;
+	~SlabPool();
+
+	void* allocate();
+	void deallocate(void* block_);
+	Usage g_usage() const;
+
+	static const std::vector<SlabPool*>& g_all();
+};
+
+
+// std allocator drawing single objects from a per-type SlabPool. Containers and
+// std::allocate_shared rebind it to their node and control block types, so those
+// get pooled as well. Array requests fall back to the heap.
+template<class T>
+class PoolAllocator {
+public:
+	using value_type = T;
+
+	PoolAllocator() = default;
+	template<class U> PoolAllocator(const PoolAllocator<U>&) {}
+
+	// Never destroyed: pooled objects may still be released by other statics at exit.
+	static SlabPool& pool() {
+		static SlabPool* tempPool = new SlabPool(typeid_name(), sizeof(T), alignof(T));
+		return *tempPool;
+	}
+
+	T* allocate(const size_t n_) {
+		if (n_ == 1) return static_cast<T*>(PoolAllocator::pool().allocate());
+		return static_cast<T*>(::operator new(n_ * sizeof(T)));
+	}
+	void deallocate(T* p_, const size_t n_) {
+		if (n_ == 1) PoolAllocator::pool().deallocate(p_);
+		else ::operator delete(p_);
+	}
+
+	template<class U> bool operator==(const PoolAllocator<U>&) const { return true; }
+	template<class U> bool operator!=(const PoolAllocator<U>&) const { return false; }
+
+private:
+	static const char* typeid_name() {
+#if defined(__GNUC__) || defined(__clang__)
+		return __PRETTY_FUNCTION__;
+#else
+		return __FUNCSIG__;
+#endif
+	}
+};
+
+
+// Vector with inline storage for at most N elements, used for the small per-actor
+// buffers so an actor record is a single pooled block.
+template<class T, size_t N>
+class InlineVector {
+private:
+	std::array<T, N> items;
+	size_t count{0};
+
+public:
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	size_t size() const { return this->count; }
+	static constexpr size_t capacity() { return N; }
+	bool empty() const { return this->count == 0; }
+	void reserve(const size_t&) {}
+
+	T* begin() { return this->items.data(); }
+	T* end() { return this->items.data() + this->count; }
+	const T* begin() const { return this->items.data(); }
+	const T* end() const { return this->items.data() + this->count; }
+
+	T& operator[](const size_t& i_) { return this->items[i_]; }
+	const T& operator[](const size_t& i_) const { return this->items[i_]; }
+	T& at(const size_t& i_) { if (i_ >= this->count) throw std::out_of_range("InlineVector"); return this->items[i_]; }
+	const T& at(const size_t& i_) const { if (i_ >= this->count) throw std::out_of_range("InlineVector"); return this->items[i_]; }
+
+	template<class... Args>
+	void emplace_back(Args&&... args_) {
+		if (this->count == N) throw std::length_error("InlineVector");
+		this->items[this->count++] = T(std::forward<Args>(args_)...);
+	}
+	void push_back(const T& item_) { this->emplace_back(item_); }
+	void pop_back() { if (this->count > 0) this->items[--this->count] = T(); }
+	void clear() { while (this->count > 0) this->pop_back(); }
+};
+
+
+
+#endif
@@ -0,0 +1,228 @@
+#include "Profiler.hpp"
+
+#include <cstdio>
+#include <cfloat>
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define PROFILER_HAS_TSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#include <x86intrin.h>
+	#define PROFILER_HAS_TSC
+#endif
+
+#include "imgui.h"
+
+
+std::atomic<bool> Profiler::enabled{false};
+
+namespace {
+
+	struct ProfileEvent {
+		const char* name;
+		uint64_t start;
+		uint64_t end;
+		uint32_t depth;
+	};
+
+	struct ThreadBuffer {
+		static const size_t capacity = 1 << 15;
+		std::array<ProfileEvent, capacity> events;
+		std::atomic<uint64_t> written{0};
+		uint64_t folded{0};
+		uint32_t depth{0};
+		uint32_t id{0};
+	};
+
+	struct ScopeStats {
+		static const size_t window = 256;
+		std::array<float, window> samples{};	// ms per call
+		size_t count{0};
+		size_t next{0};
+		uint64_t firstStart{0};
+		uint32_t depth{0};
+		uint32_t callsThisFrame{0};
+		uint32_t callsLastFrame{0};
+	};
+
+	std::mutex registryMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+	thread_local ThreadBuffer* localBuffer{nullptr};
+
+	std::unordered_map<const char*, ScopeStats> scopes;
+	std::vector<const char*> scopeOrder;
+
+	std::array<float, 240> frameTimes{};
+	size_t frameNext{0};
+	uint64_t lastFrameTicks{0};
+
+	uint64_t originTicks{0};
+	std::chrono::steady_clock::time_point originTime;
+	double ticksPerSecond{1e9};
+
+	ThreadBuffer& thread_buffer(){
+		if (localBuffer == nullptr){
+			std::lock_guard<std::mutex> tempLock(registryMutex);
+			threadBuffers.emplace_back(new ThreadBuffer());
+			localBuffer = threadBuffers.back().get();
+			localBuffer->id = static_cast<uint32_t>(threadBuffers.size());
+		}
+		return *localBuffer;
+	}
+
+	void calibrate(){
+		const double tempSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - originTime).count();
+		if (tempSeconds > 0.005) ticksPerSecond = (Profiler::now_ticks() - originTicks) / tempSeconds;
+	}
+
+	double ticks_to_ms(const uint64_t& ticks_){
+		return ticks_ * 1000.0 / ticksPerSecond;
+	}
+
+}
+
+
+void Profiler::init(){
+	originTicks = Profiler::now_ticks();
+	originTime = std::chrono::steady_clock::now();
+	lastFrameTicks = originTicks;
+	// No spin here: ticksPerSecond starts as a guess (exact for the steady_clock fallback)
+	// and is refined from the growing interval by frame() and before anything is shown.
+}
+
+uint64_t Profiler::now_ticks(){
+#ifdef PROFILER_HAS_TSC
+	return __rdtsc();
+#else
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+uint32_t& Profiler::thread_depth(){
+	return thread_buffer().depth;
+}
+
+void Profiler::record(const char* name_, const uint64_t& start_, const uint64_t& end_, const uint32_t& depth_){
+	ThreadBuffer& tempBuffer = thread_buffer();
+	const uint64_t tempIndex = tempBuffer.written.load(std::memory_order_relaxed);
+	tempBuffer.events[tempIndex % ThreadBuffer::capacity] = {name_, start_, end_, depth_};
+	tempBuffer.written.store(tempIndex + 1, std::memory_order_release);
+}
+
+void Profiler::frame(){
+	const uint64_t tempNow = Profiler::now_ticks();
+	calibrate();
+	if (Profiler::is_enabled()){
+		frameTimes[frameNext] = static_cast<float>(ticks_to_ms(tempNow - lastFrameTicks));
+		frameNext = (frameNext + 1) % frameTimes.size();
+	}
+	lastFrameTicks = tempNow;
+
+	for (auto& Si : scopes) { Si.second.callsLastFrame = Si.second.callsThisFrame; Si.second.callsThisFrame = 0; }
+
+	std::lock_guard<std::mutex> tempLock(registryMutex);
+	bool tempNewScope = false;
+	for (auto& Bi : threadBuffers){
+		const uint64_t tempWritten = Bi->written.load(std::memory_order_acquire);
+		uint64_t tempIndex = std::max(Bi->folded, tempWritten > ThreadBuffer::capacity ? tempWritten - ThreadBuffer::capacity : 0);
+		for (; tempIndex < tempWritten; tempIndex++){
+			const ProfileEvent& tempEvent = Bi->events[tempIndex % ThreadBuffer::capacity];
+			auto tempFound = scopes.find(tempEvent.name);
+			if (tempFound == scopes.end()){
+				tempFound = scopes.emplace(tempEvent.name, ScopeStats()).first;
+				tempFound->second.firstStart = tempEvent.start;
+				tempFound->second.depth = tempEvent.depth;
+				scopeOrder.push_back(tempEvent.name);
+				tempNewScope = true;
+			}
+			ScopeStats& tempStats = tempFound->second;
+			tempStats.samples[tempStats.next] = static_cast<float>(ticks_to_ms(tempEvent.end - tempEvent.start));
+			tempStats.next = (tempStats.next + 1) % ScopeStats::window;
+			tempStats.count = std::min(tempStats.count + 1, ScopeStats::window);
+			tempStats.callsThisFrame++;
+		}
+		Bi->folded = tempWritten;
+	}
+	// Scopes finish after their children, order them by first start to get the call tree back.
+	if (tempNewScope) std::sort(scopeOrder.begin(), scopeOrder.end(), [](const char* a_, const char* b_){ return scopes[a_].firstStart < scopes[b_].firstStart; });
+}
+
+void Profiler::draw_overlay(bool* open_){
+	static const char* tracePath = "metiorhail_trace.json";
+	static const char* exportStatus = "";
+	// Builds without METIORHAIL_PROFILER never call frame(), refine the rate here too.
+	calibrate();
+
+	ImGui::SetNextWindowSize({460.f, 380.f}, ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin("Profiler", open_)) { ImGui::End(); return; }
+
+	bool tempEnabled = Profiler::is_enabled();
+	if (ImGui::Checkbox("Enabled", &tempEnabled)) Profiler::set_enabled(tempEnabled);
+	ImGui::SameLine();
+	if (ImGui::Button("Export Chrome trace")) exportStatus = Profiler::export_chrome_trace(tracePath) ? tracePath : "export failed";
+	ImGui::SameLine();
+	ImGui::TextUnformatted(exportStatus);
+
+	float tempFrameAvg = 0.f;
+	for (const auto& Fi : frameTimes) tempFrameAvg += Fi;
+	tempFrameAvg /= frameTimes.size();
+	char tempOverlay[32];
+	std::snprintf(tempOverlay, sizeof(tempOverlay), "avg %.2f ms", tempFrameAvg);
+	ImGui::PlotLines("##FrameTimes", frameTimes.data(), static_cast<int>(frameTimes.size()), static_cast<int>(frameNext), tempOverlay, 0.f, FLT_MAX, {0.f, 60.f});
+
+	ImGui::Columns(5, "Scopes");
+	ImGui::SetColumnWidth(0, 200.f);
+	ImGui::Text("Scope"); ImGui::NextColumn();
+	ImGui::Text("Calls"); ImGui::NextColumn();
+	ImGui::Text("Min ms"); ImGui::NextColumn();
+	ImGui::Text("Avg ms"); ImGui::NextColumn();
+	ImGui::Text("P99 ms"); ImGui::NextColumn();
+	ImGui::Separator();
+	std::vector<float> tempSorted;
+	for (const auto& Ni : scopeOrder){
+		const ScopeStats& tempStats = scopes[Ni];
+		if (tempStats.count == 0) continue;
+		tempSorted.assign(tempStats.samples.begin(), tempStats.samples.begin() + tempStats.count);
+		std::sort(tempSorted.begin(), tempSorted.end());
+		float tempSum = 0.f;
+		for (const auto& Si : tempSorted) tempSum += Si;
+		ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 10.f * tempStats.depth);
+		ImGui::TextUnformatted(Ni); ImGui::NextColumn();
+		ImGui::Text("%u", tempStats.callsLastFrame); ImGui::NextColumn();
+		ImGui::Text("%.3f", tempSorted.front()); ImGui::NextColumn();
+		ImGui::Text("%.3f", tempSum / tempSorted.size()); ImGui::NextColumn();
+		ImGui::Text("%.3f", tempSorted[std::min(tempSorted.size() - 1, tempSorted.size() * 99 / 100)]); ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+	ImGui::End();
+}
+
+bool Profiler::export_chrome_trace(const std::string& path_){
+	calibrate();
+	FILE* tempFile = std::fopen(path_.c_str(), "w");
+	if (tempFile == nullptr) return false;
+	std::fputs("{\"traceEvents\":[\n", tempFile);
+	bool tempFirst = true;
+	{
+		std::lock_guard<std::mutex> tempLock(registryMutex);
+		for (const auto& Bi : threadBuffers){
+			const uint64_t tempWritten = Bi->written.load(std::memory_order_acquire);
+			for (uint64_t i = tempWritten > ThreadBuffer::capacity ? tempWritten - ThreadBuffer::capacity : 0; i < tempWritten; i++){
+				const ProfileEvent& tempEvent = Bi->events[i % ThreadBuffer::capacity];
+				if (tempEvent.start < originTicks) continue;
+				std::fprintf(tempFile, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+					tempFirst ? "" : ",\n", tempEvent.name, ticks_to_ms(tempEvent.start - originTicks) * 1000.0, ticks_to_ms(tempEvent.end - tempEvent.start) * 1000.0, Bi->id);
+				tempFirst = false;
+			}
+		}
+	}
+	std::fputs("\n],\"displayTimeUnit\":\"ms\"}\n", tempFile);
+	return std::fclose(tempFile) == 0;
+}
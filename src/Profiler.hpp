@@ -0,0 +1,70 @@
+#ifndef _PROFILER_HPP_
+#define _PROFILER_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <atomic>
+
+
+// Frame profiler. Scopes are timed with the TSC where available and appended to a
+// ring buffer owned by the calling thread; the UI thread folds them into per-scope
+// statistics once per frame. Compiled out entirely unless METIORHAIL_PROFILER is set,
+// and a single flag test per scope while compiled in but switched off.
+class Profiler {
+private:
+	static std::atomic<bool> enabled;
+
+	Profiler(){}
+
+public:
+	static bool is_enabled() { return Profiler::enabled.load(std::memory_order_relaxed); }
+	static void set_enabled(const bool& enabled_) { Profiler::enabled.store(enabled_, std::memory_order_relaxed); }
+
+	static void init();
+	static uint64_t now_ticks();
+	static uint32_t& thread_depth();
+	static void record(const char* name_, const uint64_t& start_, const uint64_t& end_, const uint32_t& depth_);
+
+	static void frame();
+	static void draw_overlay(bool* open_);
+	static bool export_chrome_trace(const std::string& path_);
+};
+
+
+class ProfileScope {
+private:
+	const char* name;
+	uint64_t start{0};
+	bool active;
+
+public:
+	explicit ProfileScope(const char* name_) : name{ name_ }, active{ Profiler::is_enabled() } {
+		if (!this->active) return;
+		Profiler::thread_depth()++;
+		this->start = Profiler::now_ticks();
+	}
+	~ProfileScope() {
+		if (!this->active) return;
+		const uint64_t tempEnd = Profiler::now_ticks();
+		Profiler::record(this->name, this->start, tempEnd, --Profiler::thread_depth());
+	}
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+
+#define PROFILE_CONCAT_INNER(a_, b_) a_##b_
+#define PROFILE_CONCAT(a_, b_) PROFILE_CONCAT_INNER(a_, b_)
+
+#ifdef METIORHAIL_PROFILER
+	#define PROFILE_SCOPE(name_) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name_)
+	#define PROFILE_FRAME() Profiler::frame()
+#else
+	#define PROFILE_SCOPE(name_) ((void)0)
+	#define PROFILE_FRAME() ((void)0)
+#endif
+
+
+
+#endif
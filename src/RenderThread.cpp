@@ -0,0 +1,142 @@
+#include "RenderThread.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+
+#include "GUISlot.hpp"
+#include "Utilization.hpp"
+#include "Startup.hpp"
+#include "Profiler.hpp"
+
+
+std::array<RenderThread::Frame, RenderThread::queueSize> RenderThread::frames;
+size_t RenderThread::queueHead{0};
+size_t RenderThread::queueCount{0};
+bool RenderThread::stopping{false};
+std::mutex RenderThread::queueMutex;
+std::condition_variable RenderThread::queueChanged;
+std::thread RenderThread::thread;
+std::atomic<bool> RenderThread::running{false};
+GLFWwindow* RenderThread::windowPtr{nullptr};
+uint64_t RenderThread::framesSubmitted{0};
+double RenderThread::submitWaitSeconds{0.0};
+
+
+template<class T>
+static void copy_vector(ImVector<T>& to_, const ImVector<T>& from_){
+	to_.resize(from_.Size);
+	if (from_.Size > 0) std::memcpy(to_.Data, from_.Data, static_cast<size_t>(from_.Size) * sizeof(T));
+}
+
+// Only what a renderer reads is copied: commands, vertices, indices and flags.
+void RenderThread::copy(Frame& frame_, const ImDrawData* drawData_){
+	while (frame_.lists.size() < static_cast<size_t>(drawData_->CmdListsCount)) frame_.lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+	for (int i = 0; i < drawData_->CmdListsCount; i++){
+		const ImDrawList* tempFrom = drawData_->CmdLists[i];
+		ImDrawList* tempTo = frame_.lists[static_cast<size_t>(i)];
+		copy_vector(tempTo->CmdBuffer, tempFrom->CmdBuffer);
+		copy_vector(tempTo->IdxBuffer, tempFrom->IdxBuffer);
+		copy_vector(tempTo->VtxBuffer, tempFrom->VtxBuffer);
+		tempTo->Flags = tempFrom->Flags;
+	}
+	frame_.data = *drawData_;
+	frame_.data.CmdLists = frame_.lists.empty() ? nullptr : frame_.lists.data();
+}
+
+void RenderThread::run(){
+	glfwMakeContextCurrent(RenderThread::windowPtr);
+	while (true){
+		std::unique_lock<std::mutex> tempLock(RenderThread::queueMutex);
+		RenderThread::queueChanged.wait(tempLock, [](){ return RenderThread::queueCount > 0 || RenderThread::stopping; });
+		if (RenderThread::queueCount == 0) break;
+		// The slot stays counted until it is on screen, so submit() can't overwrite it.
+		Frame& tempFrame = RenderThread::frames[RenderThread::queueHead];
+		tempLock.unlock();
+
+		{
+			PROFILE_SCOPE("RenderThread::frame");
+			Utilization::begin_gpu();
+			GUISlot::render(&tempFrame.data, tempFrame.width, tempFrame.height);
+			Utilization::end_gpu();
+			glfwSwapBuffers(RenderThread::windowPtr);
+		}
+		Utilization::frame_presented(tempFrame.input, glfwGetTime());
+		Startup::mark("first frame");
+		Startup::report();
+
+		tempLock.lock();
+		RenderThread::queueHead = (RenderThread::queueHead + 1) % queueSize;
+		RenderThread::queueCount--;
+		tempLock.unlock();
+		RenderThread::queueChanged.notify_all();
+	}
+	glFinish();
+	glfwMakeContextCurrent(nullptr);
+}
+
+void RenderThread::start(GLFWwindow* window_){
+	if (RenderThread::is_running() || window_ == nullptr) return;
+	RenderThread::windowPtr = window_;
+	RenderThread::queueHead = 0;
+	RenderThread::queueCount = 0;
+	RenderThread::stopping = false;
+	RenderThread::framesSubmitted = 0;
+	RenderThread::submitWaitSeconds = 0.0;
+	glfwMakeContextCurrent(nullptr);
+	RenderThread::running.store(true, std::memory_order_relaxed);
+	RenderThread::thread = std::thread(&RenderThread::run);
+	std::cout << "RENDER: submission thread started\n";
+}
+
+void RenderThread::stop(){
+	if (!RenderThread::is_running()) return;
+	{
+		std::lock_guard<std::mutex> tempLock(RenderThread::queueMutex);
+		RenderThread::stopping = true;
+	}
+	RenderThread::queueChanged.notify_all();
+	RenderThread::thread.join();
+	RenderThread::running.store(false, std::memory_order_relaxed);
+	glfwMakeContextCurrent(RenderThread::windowPtr);
+
+	for (auto& Fi : RenderThread::frames){
+		for (ImDrawList* Li : Fi.lists) IM_DELETE(Li);
+		Fi.lists.clear();
+	}
+	std::cout << std::fixed << std::setprecision(1) << "RENDER: " << RenderThread::framesSubmitted << " frames submitted, "
+		<< RenderThread::submitWaitSeconds * 1000.0 << " ms waiting for a free slot\n";
+	std::cout.unsetf(std::ios_base::floatfield);
+}
+
+void RenderThread::wait_for_slot(){
+	if (!RenderThread::is_running()) return;
+	std::unique_lock<std::mutex> tempLock(RenderThread::queueMutex);
+	if (RenderThread::queueCount < queueSize) return;
+	PROFILE_SCOPE("RenderThread::wait_for_slot");
+	const auto tempStart = std::chrono::steady_clock::now();
+	RenderThread::queueChanged.wait(tempLock, [](){ return RenderThread::queueCount < queueSize; });
+	RenderThread::submitWaitSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - tempStart).count();
+}
+
+void RenderThread::submit(const ImDrawData* drawData_, const int& width_, const int& height_, const InputStamps& input_){
+	if (drawData_ == nullptr || !drawData_->Valid) return;
+	PROFILE_SCOPE("RenderThread::submit");
+	RenderThread::wait_for_slot();
+	std::unique_lock<std::mutex> tempLock(RenderThread::queueMutex);
+	Frame& tempFrame = RenderThread::frames[(RenderThread::queueHead + RenderThread::queueCount) % queueSize];
+	tempLock.unlock();
+
+	// Free slots are only touched by this thread, the copy runs unlocked.
+	RenderThread::copy(tempFrame, drawData_);
+	tempFrame.width = width_;
+	tempFrame.height = height_;
+	tempFrame.input = input_;
+	RenderThread::framesSubmitted++;
+
+	tempLock.lock();
+	RenderThread::queueCount++;
+	tempLock.unlock();
+	RenderThread::queueChanged.notify_all();
+}
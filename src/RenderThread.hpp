@@ -0,0 +1,70 @@
+#ifndef _RENDER_THREAD_HPP_
+#define _RENDER_THREAD_HPP_
+
+#include <array>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "imgui.h"
+
+#include "Utilization.hpp"
+
+
+// Optional GL submission thread. While it runs it owns the window's GL context: the main
+// thread only builds frames and hands over a deep copy of the draw data through a queue
+// of two slots, so frame N+1 is built while frame N is drawn and swapped. Waiting for a
+// free slot before polling input (wait_for_slot) keeps the UI at most one frame ahead of
+// the screen and builds that frame from the freshest input. Draw callbacks, if any, run
+// on the render thread.
+class RenderThread {
+private:
+	struct Frame {
+		std::vector<ImDrawList*> lists;		// owned copies, buffers reused between frames
+		ImDrawData data;
+		int width{0};
+		int height{0};
+		InputStamps input;
+	};
+	static const size_t queueSize = 2;
+
+	static std::array<Frame, queueSize> frames;
+	static size_t queueHead;
+	static size_t queueCount;
+	static bool stopping;
+	static std::mutex queueMutex;
+	static std::condition_variable queueChanged;
+	static std::thread thread;
+	static std::atomic<bool> running;
+	static GLFWwindow* windowPtr;
+
+	static uint64_t framesSubmitted;
+	static double submitWaitSeconds;
+
+	RenderThread(){}
+
+	static void copy(Frame& frame_, const ImDrawData* drawData_);
+	static void run();
+
+public:
+	// Call with the context current on the calling thread; start() releases it to the
+	// render thread and stop() makes it current here again.
+	static void start(GLFWwindow* window_);
+	static void stop();
+	static bool is_running() { return RenderThread::running.load(std::memory_order_relaxed); }
+
+	// Blocks while both slots are taken; returns at once when the thread isn't running.
+	static void wait_for_slot();
+	// input_ stamps the input the frame answers, for the latency reported after its swap.
+	static void submit(const ImDrawData* drawData_, const int& width_, const int& height_, const InputStamps& input_);
+};
+
+
+
+#endif
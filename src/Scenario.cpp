@@ -0,0 +1,119 @@
+#include "Scenario.hpp"
+
+#include <iostream>
+#include <string>
+#include <array>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+
+#include "rand.hpp"
+#include "ActorSlot.hpp"
+#include "GamePanels.hpp"
+
+
+static const char* archetypeNames[] = {"Goblin", "Orc", "Bandit", "Cultist", "Skeleton", "Wolf", "Ghoul", "Brigand"};
+static const int maxGroup = 6;
+static const int mobOneIn = 8;
+
+
+int Scenario::stat_from_d10(const int& roll_){
+	if (roll_ <= 2) return 2;
+	if (roll_ <= 5) return 3;
+	if (roll_ <= 8) return 4;
+	return 5;
+}
+
+static std::array<int, 6> random_stats(std::mt19937& engine_){
+	std::array<int, 6> tempStats;
+	for (auto& Si : tempStats) Si = Scenario::stat_from_d10(rand_int(engine_, 1, 10));
+	return tempStats;
+}
+
+// Each action gets a random kind and a target on the other side, then the pool is rolled
+// and the first actions claim one roll entry each.
+static void prefill(ActorSlot& crea_, const std::vector<std::shared_ptr<ActorSlot>>& targets_, std::mt19937& engine_){
+	for (size_t i = 0; i < crea_.g_actions().size(); i++){
+		crea_.set_action(i, static_cast<ActorAction>(rand_int(engine_, static_cast<int>(ActorAction::Move), static_cast<int>(ActorAction::Special))));
+		if (!targets_.empty()) std::get<1>(crea_.g_actions()[i]) = targets_[static_cast<size_t>(rand_int(engine_, 0, static_cast<int>(targets_.size()) - 1))];
+	}
+	std::array<int, 64> tempFaces;
+	const size_t tempPool = std::min<size_t>(static_cast<size_t>(std::max(0, crea_.g_pool_size())), tempFaces.size());
+	for (size_t i = 0; i < tempPool; i++) tempFaces[i] = rand_int(engine_, 1, 10);
+	crea_.roll(tempFaces.data(), tempPool);
+	for (size_t i = 0; i < crea_.g_actions().size() && i < crea_.g_rolls().size(); i++) crea_.set_action_roll(i, i);
+}
+
+// Slots of one push, in the order push_actors leaves the roster: initiative first, players
+// before enemies on a tie, then players in push order and enemy groups latest first.
+struct SpawnedActor {
+	std::shared_ptr<ActorSlot> actor;
+	size_t group;
+};
+
+static bool roster_before(const SpawnedActor& a_, const SpawnedActor& b_){
+	if (a_.actor->g_initiative() != b_.actor->g_initiative()) return a_.actor->g_initiative() < b_.actor->g_initiative();
+	if (a_.actor->is_player() != b_.actor->is_player()) return a_.actor->is_player();
+	return a_.actor->is_player() ? a_.group < b_.group : a_.group > b_.group;
+}
+
+// Groups are built aside and sorted once; pushing them one by one searched the list each time.
+void Scenario::generate(const ScenarioSpec& spec_){
+	std::mt19937 tempEngine(spec_.seed);
+	std::vector<SpawnedActor> tempSpawned;
+	ActorList tempGroup;
+	size_t tempGroups = 0;
+	const auto tempSpawn = [&](const std::shared_ptr<ActorTemplate>& proto_, const bool& players_, const int& count_, const bool& asMob_){
+		GamePanels::spawn_actors(proto_, players_, count_, asMob_, tempGroup);
+		for (auto& Ai : tempGroup) tempSpawned.push_back({std::move(Ai), tempGroups});
+		tempGroup.clear();
+		tempGroups++;
+	};
+
+	tempSpawned.reserve(static_cast<size_t>(spec_.players) + static_cast<size_t>(spec_.enemies) * maxGroup);
+	for (int i = 0; i < spec_.players; i++){
+		const std::array<int, 6> tempStats = random_stats(tempEngine);
+		tempSpawn(ActorTemplate::create("Player " + std::to_string(i + 1), tempStats, 0), true, 1, false);
+	}
+
+	std::vector<std::shared_ptr<ActorTemplate>> tempArchetypes;
+	for (const char* Ni : archetypeNames){
+		const std::array<int, 6> tempStats = random_stats(tempEngine);
+		tempArchetypes.push_back(ActorTemplate::create(std::string(Ni), tempStats, rand_int(tempEngine, 0, 2)));
+	}
+	for (int tempLeft = spec_.enemies; tempLeft > 0;){
+		const int tempSize = rand_int(tempEngine, 1, maxGroup);
+		const bool tempAsMob = tempSize > 1 && rand_int(tempEngine, 1, mobOneIn) == 1;
+		const int tempCount = tempAsMob ? tempSize : std::min(tempSize, tempLeft);
+		tempSpawn(tempArchetypes[static_cast<size_t>(rand_int(tempEngine, 0, static_cast<int>(tempArchetypes.size()) - 1))], false, tempCount, tempAsMob);
+		tempLeft -= tempAsMob ? 1 : tempCount;
+	}
+
+	std::stable_sort(tempSpawned.begin(), tempSpawned.end(), roster_before);
+	ActorList tempRoster;
+	for (auto& Si : tempSpawned) tempRoster.push_back(std::move(Si.actor));
+	GamePanels::set_roster(std::move(tempRoster));
+
+	if (!spec_.prefill) return;
+	std::vector<std::shared_ptr<ActorSlot>> tempPlayers, tempEnemies;
+	for (const auto& Ai : GamePanels::g_creatures()) (Ai->is_player() ? tempPlayers : tempEnemies).push_back(Ai);
+	for (const auto& Ai : GamePanels::g_creatures()) prefill(*Ai, Ai->is_player() ? tempEnemies : tempPlayers, tempEngine);
+}
+
+bool Scenario::parse_args(const int& argc_, char** argv_, ScenarioSpec& spec_){
+	for (int i = 1; i < argc_; i++){
+		if (std::strcmp(argv_[i], "--scenario") != 0) continue;
+		if (i + 2 >= argc_){
+			std::cout << "SCENARIO: usage --scenario <players> <enemies> [seed]\n";
+			return false;
+		}
+		spec_.players = std::max(0, std::atoi(argv_[i + 1]));
+		spec_.enemies = std::max(0, std::atoi(argv_[i + 2]));
+		if (i + 3 < argc_ && argv_[i + 3][0] != '-') spec_.seed = static_cast<uint32_t>(std::strtoul(argv_[i + 3], nullptr, 10));
+		return true;
+	}
+	return false;
+}
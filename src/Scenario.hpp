@@ -0,0 +1,36 @@
+#ifndef _SCENARIO_HPP_
+#define _SCENARIO_HPP_
+
+#include <cstdint>
+
+
+struct ScenarioSpec {
+	int players{0};
+	int enemies{0};							// roster slots, a mob counts once
+	uint32_t seed{1};
+	bool prefill{true};						// actions, targets and rolls already set
+};
+
+
+// Synthetic encounters for profiling: the same spec always gives the same roster, whatever
+// the standard library.
+// Enemies come in groups of one to six drawn from a few archetypes, now and then as a mob;
+// every stat is a d10 through the Randomize Stats buckets.
+class Scenario {
+private:
+	Scenario(){}
+
+public:
+	// Randomize Stats buckets: 1-2 -> 2, 3-5 -> 3, 6-8 -> 4, 9-10 -> 5.
+	static int stat_from_d10(const int& roll_);
+
+	// Replaces the GamePanels roster.
+	static void generate(const ScenarioSpec& spec_);
+
+	// --scenario <players> <enemies> [seed]; false when the arguments don't ask for one.
+	static bool parse_args(const int& argc_, char** argv_, ScenarioSpec& spec_);
+};
+
+
+
+#endif
@@ -0,0 +1,33 @@
+#include "Startup.hpp"
+
+#include <iostream>
+#include <iomanip>
+
+
+std::chrono::steady_clock::time_point Startup::start;
+std::chrono::steady_clock::time_point Startup::last;
+std::vector<std::pair<const char*, double>> Startup::stages;
+bool Startup::reported{false};
+
+
+void Startup::begin(){
+	Startup::start = Startup::last = std::chrono::steady_clock::now();
+	Startup::stages.clear();
+	Startup::reported = false;
+}
+
+void Startup::mark(const char* stage_){
+	if (Startup::reported) return;
+	const auto tempNow = std::chrono::steady_clock::now();
+	Startup::stages.emplace_back(stage_, std::chrono::duration<double, std::milli>(tempNow - Startup::last).count());
+	Startup::last = tempNow;
+}
+
+void Startup::report(){
+	if (Startup::reported) return;
+	Startup::reported = true;
+	std::cout << "STARTUP:" << std::fixed << std::setprecision(1);
+	for (const auto& Si : Startup::stages) std::cout << " " << Si.first << " " << Si.second << " ms,";
+	std::cout << " total " << std::chrono::duration<double, std::milli>(Startup::last - Startup::start).count() << " ms\n";
+	std::cout.unsetf(std::ios_base::floatfield);
+}
@@ -0,0 +1,28 @@
+#ifndef _STARTUP_HPP_
+#define _STARTUP_HPP_
+
+#include <vector>
+#include <utility>
+#include <chrono>
+
+
+// Launch time breakdown. Each mark() closes the stage running since the previous one,
+// report() logs them all once the first frame is on screen.
+class Startup {
+private:
+	static std::chrono::steady_clock::time_point start;
+	static std::chrono::steady_clock::time_point last;
+	static std::vector<std::pair<const char*, double>> stages;
+	static bool reported;
+
+	Startup(){}
+
+public:
+	static void begin();
+	static void mark(const char* stage_);
+	static void report();
+};
+
+
+
+#endif
@@ -0,0 +1,104 @@
+#include "StringPool.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <array>
+
+
+StringPool::StringPool(){
+	this->table.assign(1024, 0);
+	this->intern("", 0);
+}
+
+StringPool& StringPool::global(){
+	static StringPool pool;
+	return pool;
+}
+
+uint32_t StringPool::hash(const char* text_, const size_t& length_){
+	uint32_t tempHash = 2166136261u;
+	for (size_t i = 0; i < length_; i++) { tempHash ^= static_cast<unsigned char>(text_[i]); tempHash *= 16777619u; }
+	return tempHash;
+}
+
+const char* StringPool::store(const char* text_, const size_t& length_){
+	const size_t tempNeeded = length_ + 1;
+	char* tempDest = nullptr;
+	if (tempNeeded > blockSize / 4){
+		this->blocks.emplace_back(new char[tempNeeded]);
+		this->reservedBytes += tempNeeded;
+		tempDest = this->blocks.back().get();
+		// Keep filling the previous block, the big string got a block of its own.
+		if (this->blocks.size() > 1) std::swap(this->blocks.back(), this->blocks[this->blocks.size() - 2]);
+	}
+	else {
+		if (this->blockUsed + tempNeeded > blockSize){
+			this->blocks.emplace_back(new char[blockSize]);
+			this->reservedBytes += blockSize;
+			this->blockUsed = 0;
+		}
+		tempDest = this->blocks.back().get() + this->blockUsed;
+		this->blockUsed += tempNeeded;
+	}
+	std::memcpy(tempDest, text_, length_);
+	tempDest[length_] = '\0';
+	return tempDest;
+}
+
+void StringPool::grow_table(){
+	std::vector<NameId> tempTable(this->table.size() * 2, 0);
+	const size_t tempMask = tempTable.size() - 1;
+	for (const auto& Ti : this->table){
+		if (Ti == 0) continue;
+		size_t tempSlot = this->hashes[Ti - 1] & tempMask;
+		while (tempTable[tempSlot] != 0) tempSlot = (tempSlot + 1) & tempMask;
+		tempTable[tempSlot] = Ti;
+	}
+	this->table.swap(tempTable);
+}
+
+NameId StringPool::intern(const char* text_, const size_t& length_){
+	const uint32_t tempHash = StringPool::hash(text_, length_);
+	const size_t tempMask = this->table.size() - 1;
+	size_t tempSlot = tempHash & tempMask;
+	while (this->table[tempSlot] != 0){
+		const NameId tempId = this->table[tempSlot] - 1;
+		if (this->hashes[tempId] == tempHash && this->lengths[tempId] == length_ && std::memcmp(this->strings[tempId], text_, length_) == 0) return tempId;
+		tempSlot = (tempSlot + 1) & tempMask;
+	}
+
+	const NameId tempId = static_cast<NameId>(this->strings.size());
+	this->strings.push_back(this->store(text_, length_));
+	this->lengths.push_back(static_cast<uint32_t>(length_));
+	this->hashes.push_back(tempHash);
+	this->table[tempSlot] = tempId + 1;
+	if (this->strings.size() * 2 > this->table.size()) this->grow_table();
+	return tempId;
+}
+
+NameId StringPool::intern(const char* text_){
+	return this->intern(text_, std::strlen(text_));
+}
+
+
+
+const char* dice_label(const int& face_, const int& count_){
+	static const int cachedFaces = 10;
+	static const int cachedCounts = 32;
+	static const std::array<std::array<NameId, cachedCounts>, cachedFaces + 1> labels = [](){
+		std::array<std::array<NameId, cachedCounts>, cachedFaces + 1> tempLabels;
+		char tempBuffer[32];
+		for (int f = 0; f <= cachedFaces; f++){
+			for (int c = 0; c < cachedCounts; c++){
+				const int tempLength = std::snprintf(tempBuffer, sizeof(tempBuffer), "%i: %i", f, c);
+				tempLabels[f][c] = StringPool::global().intern(tempBuffer, static_cast<size_t>(tempLength));
+			}
+		}
+		return tempLabels;
+	}();
+
+	if (face_ >= 0 && face_ <= cachedFaces && count_ >= 0 && count_ < cachedCounts) return name_str(labels[face_][count_]);
+	char tempBuffer[32];
+	const int tempLength = std::snprintf(tempBuffer, sizeof(tempBuffer), "%i: %i", face_, count_);
+	return name_str(StringPool::global().intern(tempBuffer, static_cast<size_t>(tempLength)));
+}
@@ -0,0 +1,57 @@
+#ifndef _STRING_POOL_HPP_
+#define _STRING_POOL_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+
+
+using NameId = uint32_t;
+
+// Interned, null terminated strings packed into large blocks. An id and the pointer
+// behind it stay valid for the lifetime of the pool, so callers can keep either one.
+class StringPool {
+private:
+	static const size_t blockSize = 64 * 1024;
+
+	std::vector<std::unique_ptr<char[]>> blocks;
+	size_t blockUsed{blockSize};
+	size_t reservedBytes{0};
+	std::vector<const char*> strings;
+	std::vector<uint32_t> lengths;
+	std::vector<uint32_t> hashes;
+	std::vector<NameId> table;				// open addressing, id + 1, 0 when empty
+
+	static uint32_t hash(const char* text_, const size_t& length_);
+	const char* store(const char* text_, const size_t& length_);
+	void grow_table();
+
+public:
+	StringPool();
+	StringPool(const StringPool&) = delete;
+	StringPool& operator=(const StringPool&) = delete;
+
+	static StringPool& global();
+
+	NameId intern(const char* text_, const size_t& length_);
+	NameId intern(const char* text_);
+	NameId intern(const std::string& text_) { return this->intern(text_.c_str(), text_.size()); }
+
+	const char* c_str(const NameId& id_) const { return this->strings[id_]; }
+	size_t length(const NameId& id_) const { return this->lengths[id_]; }
+	size_t size() const { return this->strings.size(); }
+	// Bytes of the text blocks, index tables not included.
+	size_t reserved() const { return this->reservedBytes; }
+};
+
+inline const char* name_str(const NameId& id_) { return StringPool::global().c_str(id_); }
+
+
+// "face: count" labels used by the dice combos, formatted once.
+const char* dice_label(const int& face_, const int& count_);
+
+
+
+#endif
@@ -0,0 +1,134 @@
+#include "TextLayout.hpp"
+
+#include <cfloat>
+#include <cstring>
+
+#include "imgui_internal.h"
+
+
+std::unordered_map<TextLayout::Key, TextLayout::Entry, TextLayout::KeyHash> TextLayout::entries;
+ImDrawList* TextLayout::scratch{nullptr};
+int TextLayout::lastSweep{0};
+
+static const int sweepInterval = 600;
+
+size_t TextLayout::KeyHash::operator()(const Key& key_) const {
+	uint32_t tempWidth, tempSize;
+	std::memcpy(&tempWidth, &key_.wrapWidth, sizeof(float));
+	std::memcpy(&tempSize, &key_.fontSize, sizeof(float));
+	uint64_t tempHash = (key_.text ^ static_cast<uint64_t>(tempWidth) << 32) * 0x9E3779B97F4A7C15ull;
+	tempHash ^= (reinterpret_cast<uintptr_t>(key_.font) ^ tempSize) * 0xC2B2AE3D27D4EB4Full;
+	return static_cast<size_t>(tempHash ^ (tempHash >> 29));
+}
+
+// Runs ImFont::RenderText once into a scratch list at the origin and keeps its quads,
+// so breaks and glyph positions are exactly the ones TextWrapped would produce.
+const TextLayout::Entry& TextLayout::get(const Key& key_, const char* text_, const char* textEnd_){
+	auto tempFound = TextLayout::entries.find(key_);
+	const bool tempPooled = (key_.text >> 63) == 0;
+	if (tempFound != TextLayout::entries.end()){
+		tempFound->second.lastFrame = ImGui::GetFrameCount();
+		if (tempPooled || tempFound->second.source.compare(0, std::string::npos, text_, static_cast<size_t>(textEnd_ - text_)) == 0) return tempFound->second;
+		// Hash collision, the newer text takes the entry over.
+		tempFound->second = Entry();
+	}
+
+	Entry& tempEntry = TextLayout::entries[key_];
+	tempEntry.lastFrame = ImGui::GetFrameCount();
+	if (!tempPooled) tempEntry.source.assign(text_, textEnd_);
+	const char* tempText = text_;
+	const char* tempTextEnd = textEnd_;
+	if (tempText == tempTextEnd){
+		tempEntry.size = ImVec2(0.f, key_.fontSize);
+		return tempEntry;
+	}
+	tempEntry.size = key_.font->CalcTextSizeA(key_.fontSize, FLT_MAX, key_.wrapWidth, tempText, tempTextEnd);
+	tempEntry.size.x = IM_FLOOR(tempEntry.size.x + 0.95f);
+
+	if (TextLayout::scratch == nullptr) TextLayout::scratch = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+	TextLayout::scratch->_ResetForNewFrame();
+	key_.font->RenderText(TextLayout::scratch, key_.fontSize, ImVec2(0.f, 0.f), IM_COL32_WHITE, ImVec4(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX), tempText, tempTextEnd, key_.wrapWidth, false);
+	const ImVector<ImDrawVert>& tempVtx = TextLayout::scratch->VtxBuffer;
+	tempEntry.quads.reserve(static_cast<size_t>(tempVtx.Size / 4));
+	for (int i = 0; i + 3 < tempVtx.Size; i += 4) tempEntry.quads.push_back({tempVtx[i].pos, tempVtx[i + 2].pos, tempVtx[i].uv, tempVtx[i + 2].uv});
+	return tempEntry;
+}
+
+void TextLayout::text(const NameId& text_){
+	const char* tempText = name_str(text_);
+	TextLayout::draw(text_, tempText, tempText + StringPool::global().length(text_));
+}
+
+void TextLayout::text(const char* text_){
+	const size_t tempLength = std::strlen(text_);
+	uint64_t tempHash = 14695981039346656037ull;
+	for (size_t i = 0; i < tempLength; i++) { tempHash ^= static_cast<unsigned char>(text_[i]); tempHash *= 1099511628211ull; }
+	TextLayout::draw(tempHash | 1ull << 63, text_, text_ + tempLength);
+}
+
+void TextLayout::draw(const uint64_t& key_, const char* text_, const char* textEnd_){
+	ImGuiContext& g = *GImGui;
+	ImGuiWindow* window = ImGui::GetCurrentWindow();
+	if (window->SkipItems) return;
+	TextLayout::sweep();
+
+	// Mirrors ImGui::TextEx for short text.
+	const ImVec2 tempPos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
+	const float tempWrapPos = window->DC.TextWrapPos;
+	const float tempWrapWidth = tempWrapPos >= 0.f ? ImGui::CalcWrapWidthForPos(window->DC.CursorPos, tempWrapPos) : 0.f;
+	const Entry& tempEntry = TextLayout::get({key_, tempWrapWidth, g.Font, g.FontSize}, text_, textEnd_);
+
+	const ImRect tempBB(tempPos, ImVec2(tempPos.x + tempEntry.size.x, tempPos.y + tempEntry.size.y));
+	ImGui::ItemSize(tempEntry.size, 0.f);
+	if (!ImGui::ItemAdd(tempBB, 0)) return;
+	if (g.LogEnabled) ImGui::LogRenderedText(&tempPos, text_, textEnd_);
+
+	const ImU32 tempColor = ImGui::GetColorU32(ImGuiCol_Text);
+	if ((tempColor & IM_COL32_A_MASK) == 0 || tempEntry.quads.empty()) return;
+	ImDrawList* tempDrawList = window->DrawList;
+	const ImVec4& tempClip = tempDrawList->_CmdHeader.ClipRect;
+	const ImVec2 tempOrigin(IM_FLOOR(tempPos.x), IM_FLOOR(tempPos.y));
+	// Quads entirely outside the clip rect are dropped, like RenderText's coarse clipping.
+	const auto tempVisible = [&](const Quad& quad_){
+		return tempOrigin.x + quad_.max.x >= tempClip.x && tempOrigin.x + quad_.min.x <= tempClip.z && tempOrigin.y + quad_.max.y >= tempClip.y && tempOrigin.y + quad_.min.y <= tempClip.w;
+	};
+	int tempCount = 0;
+	for (const Quad& Qi : tempEntry.quads) tempCount += tempVisible(Qi) ? 1 : 0;
+	if (tempCount == 0) return;
+	tempDrawList->PrimReserve(tempCount * 6, tempCount * 4);
+	for (const Quad& Qi : tempEntry.quads){
+		if (!tempVisible(Qi)) continue;
+		tempDrawList->PrimRectUV(ImVec2(tempOrigin.x + Qi.min.x, tempOrigin.y + Qi.min.y), ImVec2(tempOrigin.x + Qi.max.x, tempOrigin.y + Qi.max.y), Qi.uvMin, Qi.uvMax, tempColor);
+	}
+}
+
+void TextLayout::text_wrapped(const NameId& text_){
+	const bool tempPush = ImGui::GetCurrentWindow()->DC.TextWrapPos < 0.f;
+	if (tempPush) ImGui::PushTextWrapPos(0.f);
+	TextLayout::text(text_);
+	if (tempPush) ImGui::PopTextWrapPos();
+}
+
+void TextLayout::text_wrapped(const char* text_){
+	const bool tempPush = ImGui::GetCurrentWindow()->DC.TextWrapPos < 0.f;
+	if (tempPush) ImGui::PushTextWrapPos(0.f);
+	TextLayout::text(text_);
+	if (tempPush) ImGui::PopTextWrapPos();
+}
+
+void TextLayout::sweep(){
+	const int tempFrame = ImGui::GetFrameCount();
+	if (tempFrame - TextLayout::lastSweep < sweepInterval) return;
+	TextLayout::lastSweep = tempFrame;
+	for (auto Ei = TextLayout::entries.begin(); Ei != TextLayout::entries.end();){
+		if (tempFrame - Ei->second.lastFrame >= sweepInterval) Ei = TextLayout::entries.erase(Ei);
+		else ++Ei;
+	}
+}
+
+void TextLayout::clear(){
+	TextLayout::entries.clear();
+	if (TextLayout::scratch != nullptr) IM_DELETE(TextLayout::scratch);
+	TextLayout::scratch = nullptr;
+	TextLayout::lastSweep = 0;
+}
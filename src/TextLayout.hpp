@@ -0,0 +1,70 @@
+#ifndef _TEXT_LAYOUT_HPP_
+#define _TEXT_LAYOUT_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "imgui.h"
+
+#include "StringPool.hpp"
+
+
+// Laid out text, keyed by (interned text, wrap width, font, font size). The glyph
+// quads and the item size are measured once; drawing an entry is a copy of its quads
+// into the window draw list, translated and tinted. Output and layout match
+// ImGui::Text/TextWrapped. Entries unused for a while (old wrap widths) are dropped.
+// Text that isn't interned is keyed by a hash of its content and keeps a copy to check it.
+class TextLayout {
+private:
+	struct Key {
+		uint64_t text;						// NameId, or the content hash with the top bit set
+		float wrapWidth;
+		const ImFont* font;
+		float fontSize;
+
+		bool operator==(const Key& other_) const { return this->text == other_.text && this->wrapWidth == other_.wrapWidth && this->font == other_.font && this->fontSize == other_.fontSize; }
+	};
+	struct KeyHash {
+		size_t operator()(const Key& key_) const;
+	};
+	struct Quad {
+		ImVec2 min;
+		ImVec2 max;
+		ImVec2 uvMin;
+		ImVec2 uvMax;
+	};
+	struct Entry {
+		std::vector<Quad> quads;			// relative to the floored text position
+		ImVec2 size;
+		int lastFrame{0};
+		std::string source;					// only for text that isn't interned
+	};
+
+	static std::unordered_map<Key, Entry, KeyHash> entries;
+	static ImDrawList* scratch;
+	static int lastSweep;
+
+	static const Entry& get(const Key& key_, const char* text_, const char* textEnd_);
+	static void draw(const uint64_t& key_, const char* text_, const char* textEnd_);
+	static void sweep();
+
+	TextLayout(){}
+
+public:
+	// Same as ImGui::Text("%s", ...) / ImGui::TextWrapped("%s", ...) for an interned string.
+	static void text(const NameId& text_);
+	static void text_wrapped(const NameId& text_);
+	// For per-instance strings that would grow the pool for good.
+	static void text(const char* text_);
+	static void text_wrapped(const char* text_);
+
+	static void clear();
+	static size_t size() { return TextLayout::entries.size(); }
+};
+
+
+
+#endif
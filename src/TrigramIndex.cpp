@@ -0,0 +1,97 @@
+#include "TrigramIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+
+static const unsigned char trigramPad = 1;
+static const size_t compactMinimum = 1024;
+
+
+void TrigramIndex::collect_trigrams(const char* text_, size_t length_, std::vector<uint32_t>& out_){
+	out_.clear();
+	uint32_t tempKey = (trigramPad << 8) | trigramPad;
+	for (size_t i = 0; i < length_; i++){
+		const unsigned char tempChar = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(text_[i])));
+		tempKey = ((tempKey << 8) | tempChar) & 0xFFFFFFu;
+		out_.push_back(tempKey);
+	}
+	std::sort(out_.begin(), out_.end());
+	out_.erase(std::unique(out_.begin(), out_.end()), out_.end());
+}
+
+uint32_t TrigramIndex::add(const char* text_, size_t length_){
+	const uint32_t tempId = static_cast<uint32_t>(this->lengths.size());
+	std::vector<uint32_t> tempTrigrams;
+	TrigramIndex::collect_trigrams(text_, length_, tempTrigrams);
+	for (const auto& Ti : tempTrigrams) this->postings[Ti].push_back(tempId);
+	this->lengths.push_back(static_cast<uint16_t>(std::min<size_t>(length_, UINT16_MAX)));
+	this->removed.push_back(false);
+	return tempId;
+}
+
+void TrigramIndex::remove(const uint32_t& id_){
+	if (id_ >= this->removed.size() || this->removed[id_]) return;
+	this->removed[id_] = true;
+	this->removedCount++;
+	this->staleCount++;
+	if (this->staleCount >= compactMinimum && this->staleCount > this->g_live()) this->compact();
+}
+
+void TrigramIndex::compact(){
+	for (auto Pi = this->postings.begin(); Pi != this->postings.end();){
+		auto& tempIds = Pi->second;
+		tempIds.erase(std::remove_if(tempIds.begin(), tempIds.end(), [this](const uint32_t& id_){ return this->removed[id_]; }), tempIds.end());
+		if (tempIds.empty()) Pi = this->postings.erase(Pi);
+		else ++Pi;
+	}
+	this->staleCount = 0;
+}
+
+void TrigramIndex::clear(){
+	this->postings.clear();
+	this->lengths.clear();
+	this->removed.clear();
+	this->removedCount = 0;
+	this->staleCount = 0;
+	this->scores.clear();
+	this->touched.clear();
+}
+
+void TrigramIndex::search(const char* query_, size_t maxResults_, std::vector<uint32_t>& results_) const {
+	results_.clear();
+	size_t tempLength = 0;
+	while (query_[tempLength] != '\0') tempLength++;
+	if (tempLength == 0 || maxResults_ == 0) return;
+
+	std::vector<uint32_t> tempTrigrams;
+	TrigramIndex::collect_trigrams(query_, tempLength, tempTrigrams);
+
+	this->scores.resize(this->lengths.size(), 0);
+	this->touched.clear();
+	for (const auto& Ti : tempTrigrams){
+		const auto tempPosting = this->postings.find(Ti);
+		if (tempPosting == this->postings.end()) continue;
+		for (const auto& Pi : tempPosting->second){
+			if (this->scores[Pi]++ == 0) this->touched.push_back(Pi);
+		}
+	}
+
+	// Half of the trigrams fully inside the query must hit; short queries only need the prefix.
+	const uint16_t tempThreshold = static_cast<uint16_t>(std::max<size_t>(1, (tempLength > 2 ? tempLength - 2 : 0) / 2));
+	for (const auto& Ci : this->touched){
+		if (this->scores[Ci] >= tempThreshold && !this->removed[Ci]) results_.push_back(Ci);
+	}
+	const auto tempBetter = [this](const uint32_t& a_, const uint32_t& b_){
+		if (this->scores[a_] != this->scores[b_]) return this->scores[a_] > this->scores[b_];
+		if (this->lengths[a_] != this->lengths[b_]) return this->lengths[a_] < this->lengths[b_];
+		return a_ < b_;
+	};
+	if (results_.size() > maxResults_){
+		std::partial_sort(results_.begin(), results_.begin() + maxResults_, results_.end(), tempBetter);
+		results_.resize(maxResults_);
+	}
+	else std::sort(results_.begin(), results_.end(), tempBetter);
+
+	for (const auto& Ci : this->touched) this->scores[Ci] = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef _TRIGRAM_INDEX_HPP_
+#define _TRIGRAM_INDEX_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+
+// Case-insensitive fuzzy name index. Every key is split into trigrams (padded at the
+// front so one and two letter queries still match as prefixes) and ids are appended
+// to the posting list of each trigram, so adding a key never rebuilds anything.
+// Removed ids are tombstoned and skipped by search; their postings are dropped in one
+// pass once the dead ids outnumber the live ones. Ids are never reused.
+class TrigramIndex {
+private:
+	std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+	std::vector<uint16_t> lengths;
+	std::vector<bool> removed;
+	size_t removedCount{0};
+	size_t staleCount{0};					// removed ids still in the posting lists
+
+	mutable std::vector<uint16_t> scores;
+	mutable std::vector<uint32_t> touched;
+
+	static void collect_trigrams(const char* text_, size_t length_, std::vector<uint32_t>& out_);
+	void compact();
+
+public:
+	TrigramIndex() = default;
+
+	// Ids handed out so far, removed ones included.
+	size_t size() const { return this->lengths.size(); }
+	size_t g_live() const { return this->lengths.size() - this->removedCount; }
+
+	uint32_t add(const char* text_, size_t length_);
+	void remove(const uint32_t& id_);
+	void clear();
+	// Best matches first: most shared trigrams, then shortest key.
+	void search(const char* query_, size_t maxResults_, std::vector<uint32_t>& results_) const;
+};
+
+
+
+#endif
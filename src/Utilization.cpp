@@ -0,0 +1,142 @@
+#include "Utilization.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+
+std::array<GLuint, Utilization::queryCount> Utilization::queries{};
+std::array<bool, Utilization::queryCount> Utilization::queryPending{};
+size_t Utilization::queryNext{0};
+bool Utilization::queryActive{false};
+double Utilization::windowStart{0.0};
+double Utilization::cpuStart{0.0};
+double Utilization::gpuSeconds{0.0};
+uint64_t Utilization::framesRendered{0};
+uint64_t Utilization::wakeupsSkipped{0};
+double Utilization::reportInterval{10.0};
+double Utilization::latencySum{0.0};
+double Utilization::latencyMax{0.0};
+uint64_t Utilization::latencyFrames{0};
+double Utilization::clickSum{0.0};
+double Utilization::clickMax{0.0};
+uint64_t Utilization::clickFrames{0};
+std::mutex Utilization::statsMutex;
+
+
+double Utilization::process_cpu_seconds(){
+#ifdef _WIN32
+	FILETIME tempCreation, tempExit, tempKernel, tempUser;
+	if (!GetProcessTimes(GetCurrentProcess(), &tempCreation, &tempExit, &tempKernel, &tempUser)) return 0.0;
+	const auto tempToSeconds = [](const FILETIME& time_){ return ((static_cast<uint64_t>(time_.dwHighDateTime) << 32) | time_.dwLowDateTime) * 1e-7; };
+	return tempToSeconds(tempKernel) + tempToSeconds(tempUser);
+#else
+	timespec tempTime;
+	if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &tempTime) != 0) return 0.0;
+	return tempTime.tv_sec + tempTime.tv_nsec * 1e-9;
+#endif
+}
+
+void Utilization::init(const double& now_, const double& reportInterval_){
+	glGenQueries(static_cast<GLsizei>(queryCount), Utilization::queries.data());
+	Utilization::queryPending.fill(false);
+	Utilization::reportInterval = reportInterval_;
+	Utilization::windowStart = now_;
+	Utilization::cpuStart = Utilization::process_cpu_seconds();
+}
+
+void Utilization::destroy(const double& now_){
+	Utilization::collect_queries(true);
+	Utilization::report(now_);
+	glDeleteQueries(static_cast<GLsizei>(queryCount), Utilization::queries.data());
+}
+
+void Utilization::collect_queries(const bool& wait_){
+	for (size_t i = 0; i < queryCount; i++){
+		if (!Utilization::queryPending[i]) continue;
+		GLint tempAvailable = 0;
+		if (!wait_) glGetQueryObjectiv(Utilization::queries[i], GL_QUERY_RESULT_AVAILABLE, &tempAvailable);
+		if (!wait_ && !tempAvailable) continue;
+		GLuint64 tempNanoseconds = 0;
+		glGetQueryObjectui64v(Utilization::queries[i], GL_QUERY_RESULT, &tempNanoseconds);
+		std::lock_guard<std::mutex> tempLock(Utilization::statsMutex);
+		Utilization::gpuSeconds += tempNanoseconds * 1e-9;
+		Utilization::queryPending[i] = false;
+	}
+}
+
+// Queries are collected here rather than in update(), on the thread that owns the context.
+void Utilization::begin_gpu(){
+	Utilization::collect_queries(false);
+	{
+		std::lock_guard<std::mutex> tempLock(Utilization::statsMutex);
+		Utilization::framesRendered++;
+	}
+	// Every slot still in flight: skip timing this frame rather than stall on a result.
+	if (Utilization::queryPending[Utilization::queryNext]) return;
+	glBeginQuery(GL_TIME_ELAPSED, Utilization::queries[Utilization::queryNext]);
+	Utilization::queryActive = true;
+}
+
+void Utilization::end_gpu(){
+	if (!Utilization::queryActive) return;
+	glEndQuery(GL_TIME_ELAPSED);
+	Utilization::queryActive = false;
+	Utilization::queryPending[Utilization::queryNext] = true;
+	Utilization::queryNext = (Utilization::queryNext + 1) % queryCount;
+}
+
+void Utilization::frame_presented(const InputStamps& input_, const double& now_){
+	if (input_.input < 0.0) return;
+	std::lock_guard<std::mutex> tempLock(Utilization::statsMutex);
+	Utilization::latencySum += now_ - input_.input;
+	Utilization::latencyMax = std::max(Utilization::latencyMax, now_ - input_.input);
+	Utilization::latencyFrames++;
+	if (input_.click < 0.0) return;
+	Utilization::clickSum += now_ - input_.click;
+	Utilization::clickMax = std::max(Utilization::clickMax, now_ - input_.click);
+	Utilization::clickFrames++;
+}
+
+void Utilization::update(const double& now_){
+	if (now_ - Utilization::windowStart >= Utilization::reportInterval) Utilization::report(now_);
+}
+
+void Utilization::report(const double& now_){
+	const double tempWall = now_ - Utilization::windowStart;
+	if (tempWall <= 0.0) return;
+	const double tempCpu = Utilization::process_cpu_seconds();
+	std::lock_guard<std::mutex> tempLock(Utilization::statsMutex);
+	const uint64_t tempWakeups = Utilization::framesRendered + Utilization::wakeupsSkipped;
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< "UTIL: " << Utilization::framesRendered / tempWall << " fps, cpu " << 100.0 * (tempCpu - Utilization::cpuStart) / tempWall
+		<< "%, gpu " << 100.0 * Utilization::gpuSeconds / tempWall << "%, "
+		<< (tempWakeups ? 100.0 * Utilization::wakeupsSkipped / tempWakeups : 0.0) << "% idle wake-ups";
+	if (Utilization::latencyFrames > 0) std::cout << ", input to swap " << 1000.0 * Utilization::latencySum / Utilization::latencyFrames
+		<< " ms avg " << 1000.0 * Utilization::latencyMax << " ms max";
+	if (Utilization::clickFrames > 0) std::cout << ", click to swap " << 1000.0 * Utilization::clickSum / Utilization::clickFrames
+		<< " ms avg " << 1000.0 * Utilization::clickMax << " ms max";
+	std::cout << "\n";
+	std::cout.unsetf(std::ios_base::floatfield);
+
+	Utilization::windowStart = now_;
+	Utilization::cpuStart = tempCpu;
+	Utilization::gpuSeconds = 0.0;
+	Utilization::framesRendered = 0;
+	Utilization::wakeupsSkipped = 0;
+	Utilization::latencySum = 0.0;
+	Utilization::latencyMax = 0.0;
+	Utilization::latencyFrames = 0;
+	Utilization::clickSum = 0.0;
+	Utilization::clickMax = 0.0;
+	Utilization::clickFrames = 0;
+}
@@ -0,0 +1,67 @@
+#ifndef _UTILIZATION_HPP_
+#define _UTILIZATION_HPP_
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+
+#include <glad/glad.h>
+
+
+// Times of the input a frame answers, stamped by the event callbacks.
+struct InputStamps {
+	double input{-1.0};						// first input event since the previous frame, negative if none
+	double click{-1.0};						// first mouse button press, negative if none
+};
+
+
+// Process CPU time, GPU time of rendered frames (timer queries), the share of loop
+// wake-ups that did not need a frame and the input to swap latency, logged periodically
+// and at shutdown. The GPU half may run on a render thread, counters are shared under
+// a mutex.
+class Utilization {
+private:
+	static const size_t queryCount = 4;
+
+	static std::array<GLuint, queryCount> queries;
+	static std::array<bool, queryCount> queryPending;
+	static size_t queryNext;
+	static bool queryActive;
+
+	static double windowStart;
+	static double cpuStart;
+	static double gpuSeconds;
+	static uint64_t framesRendered;
+	static uint64_t wakeupsSkipped;
+	static double reportInterval;
+	static double latencySum;
+	static double latencyMax;
+	static uint64_t latencyFrames;
+	static double clickSum;
+	static double clickMax;
+	static uint64_t clickFrames;
+	static std::mutex statsMutex;
+
+	Utilization(){}
+
+	static double process_cpu_seconds();
+	static void collect_queries(const bool& wait_);
+
+public:
+	static void init(const double& now_, const double& reportInterval_ = 10.0);
+	static void destroy(const double& now_);
+
+	static void begin_gpu();
+	static void end_gpu();
+	static void frame_skipped() { Utilization::wakeupsSkipped++; }
+	// After the swap of a frame, for the input to swap and click to swap latencies.
+	static void frame_presented(const InputStamps& input_, const double& now_);
+
+	static void update(const double& now_);
+	static void report(const double& now_);
+};
+
+
+
+#endif
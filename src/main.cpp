@@ -1,4 +1,6 @@
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
 
 
 #include <glad/glad.h>
@@ -11,6 +13,12 @@
 
 #include "rand.hpp"
 #include "GUISlot.hpp"
+#include "Utilization.hpp"
+#include "Startup.hpp"
+#include "RenderThread.hpp"
+#include "FramePacer.hpp"
+#include "Scenario.hpp"
+#include "DiceReservoir.hpp"
 
 #pragma comment(linker, "/subsystem:\"windows\" /entry:\"mainCRTStartup\"")
 
@@ -18,6 +26,11 @@
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+void char_callback(GLFWwindow* window, unsigned int codepoint);
+void refresh_callback(GLFWwindow* window);
+void focus_callback(GLFWwindow* window, int focused);
 void processInput(GLFWwindow *window);
 
 
@@ -25,11 +38,11 @@ void processInput(GLFWwindow *window);
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 700;
 
-int main() {
+int main(int argc, char** argv) {
+	Startup::begin();
 	glfwInit();
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_SAMPLES, 4);
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 	glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
 	//glfwWindowHint(GLFW_DECORATED, GLFW_FALSE);
@@ -50,10 +63,16 @@ int main() {
 		return -1;
 	}
 	glfwMakeContextCurrent(window);
+	Startup::mark("window");
 	glfwSwapInterval(1);
 	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 	glfwSetCursorPosCallback(window, mouse_callback);
 	glfwSetScrollCallback(window, scroll_callback);
+	glfwSetMouseButtonCallback(window, mouse_button_callback);
+	glfwSetKeyCallback(window, key_callback);
+	glfwSetCharCallback(window, char_callback);
+	glfwSetWindowRefreshCallback(window, refresh_callback);
+	glfwSetWindowFocusCallback(window, focus_callback);
 
 
 	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
@@ -65,6 +84,7 @@ int main() {
 		std::cout << "Failed to initialize GLAD" << std::endl;
 		return -1;
 	}
+	Startup::mark("loader");
 
 	glEnable(GL_DEPTH_TEST);
 
@@ -81,25 +101,70 @@ int main() {
 
  	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	GUISlot::init(window);
+	const char* tempProjector = std::getenv("METIORHAIL_PROJECTOR");
+	// Persistent mapped streaming buffers in the OpenGL3 backend, off unless asked for.
+	const char* tempFastPath = std::getenv("METIORHAIL_GL_FAST_PATH");
+	GUISlot::init(window, tempProjector != nullptr && std::strcmp(tempProjector, "1") == 0, tempFastPath != nullptr && std::strcmp(tempFastPath, "1") == 0);
+	// --scenario <players> <enemies> [seed] starts on a generated encounter, for profiling.
+	ScenarioSpec tempScenario;
+	if (Scenario::parse_args(argc, argv, tempScenario)) Scenario::generate(tempScenario);
+	// Rolls come pre-rolled from a background thread, or from a fixed seed to replay a session.
+	const char* tempDiceSeed = std::getenv("METIORHAIL_DICE_SEED");
+	if (tempDiceSeed != nullptr && tempDiceSeed[0] != '\0') DiceReservoir::set_replay(true, static_cast<uint32_t>(std::strtoul(tempDiceSeed, nullptr, 10)));
+	DiceReservoir::start();
+	Utilization::init(glfwGetTime());
+	// GL submission and swaps on their own thread, the loop below only builds frames.
+	const char* tempRenderThread = std::getenv("METIORHAIL_RENDER_THREAD");
+	if (tempRenderThread != nullptr && std::strcmp(tempRenderThread, "1") == 0) RenderThread::start(window);
+	// Input polled and frames built just before the vblank; paces the serial path only.
+	const char* tempLowLatency = std::getenv("METIORHAIL_LOW_LATENCY");
+	FramePacer::init(window, tempLowLatency != nullptr && std::strcmp(tempLowLatency, "1") == 0 && !RenderThread::is_running());
 	
 
 	// render loop
 	// -----------
+	// Nothing is rebuilt while the screen is static: the loop sleeps in
+	// glfwWaitEventsTimeout until a callback marks the GUI dirty.
 	while (!glfwWindowShouldClose(window)) {
 		
-		glfwPollEvents();
+		if (GUISlot::needs_frame(glfwGetTime())) {
+			RenderThread::wait_for_slot();
+			FramePacer::wait();
+			glfwPollEvents();
+		}
+		else glfwWaitEventsTimeout(GUISlot::g_wait_timeout());
 		processInput(window);
+		Utilization::update(glfwGetTime());
+
+		if (!GUISlot::needs_frame(glfwGetTime())) {
+			Utilization::frame_skipped();
+			continue;
+		}
 	
-		glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		if (RenderThread::is_running()) {
+			GUISlot::draw();
+			continue;
+		}
 
+		Utilization::begin_gpu();
 		GUISlot::draw();
+		Utilization::end_gpu();
+		FramePacer::frame_built(glfwGetTime());
 		
 		glfwSwapBuffers(window);
+		// Returns at the vblank, which is what the pacer measures.
+		if (FramePacer::is_enabled()) glFinish();
+		FramePacer::frame_swapped(glfwGetTime());
+		Utilization::frame_presented(GUISlot::g_frame_input(), glfwGetTime());
+		Startup::mark("first frame");
+		Startup::report();
 	}
 
 
+	RenderThread::stop();
+	DiceReservoir::stop();
+	FramePacer::report();
+	Utilization::destroy(glfwGetTime());
 	GUISlot::destroy();
 
 
@@ -117,19 +182,44 @@ void processInput(GLFWwindow *window){
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
-
-	glViewport(0, 0, width, height);
+	// No GL here, the context may belong to the render thread; the next frame sets the viewport.
+	GUISlot::mark_dirty();
 }
 
 
 void mouse_callback(GLFWwindow* window, double xpos, double ypos)
 {
-	
+	GUISlot::input_received(glfwGetTime());
 }
 
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
-	
+	GUISlot::input_received(glfwGetTime());
+}
+
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
+{
+	GUISlot::input_received(glfwGetTime(), action == GLFW_PRESS);
+}
+
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+	GUISlot::input_received(glfwGetTime());
+}
+
+void char_callback(GLFWwindow* window, unsigned int codepoint)
+{
+	GUISlot::input_received(glfwGetTime());
+}
+
+void refresh_callback(GLFWwindow* window)
+{
+	GUISlot::mark_dirty();
+}
+
+void focus_callback(GLFWwindow* window, int focused)
+{
+	GUISlot::mark_dirty();
 }
 
 
@@ -10,3 +10,14 @@ int rand_int(const int Min, const int Max) {
 	return RandInterval(e1);
 }
 
+int rand_int(std::mt19937& engine_, const int& min_, const int& max_) {
+	if (min_ > max_) throw "M < m!";
+	const uint32_t tempRange = static_cast<uint32_t>(static_cast<int64_t>(max_) - min_ + 1);
+	if (tempRange == 0) return static_cast<int>(static_cast<uint32_t>(engine_()));
+	uint64_t tempProduct = static_cast<uint64_t>(static_cast<uint32_t>(engine_())) * tempRange;
+	if (static_cast<uint32_t>(tempProduct) < tempRange){
+		const uint32_t tempThreshold = (0u - tempRange) % tempRange;
+		while (static_cast<uint32_t>(tempProduct) < tempThreshold) tempProduct = static_cast<uint64_t>(static_cast<uint32_t>(engine_())) * tempRange;
+	}
+	return static_cast<int>(static_cast<int64_t>(min_) + static_cast<int64_t>(tempProduct >> 32));
+}
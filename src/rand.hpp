@@ -1,9 +1,13 @@
 #ifndef _RAND_H_
 #define _RAND_H_
 
+#include <cstdint>
 #include <random>
 
 int rand_int(const int Min, const int Max);
+// Uniform in [min_, max_] from the engine's raw 32-bit output (multiply, reject the biased
+// low part), so a seed gives the same sequence with every standard library.
+int rand_int(std::mt19937& engine_, const int& min_, const int& max_);
 
 
 